@@ -0,0 +1,233 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include "crow_all.h"
+#include "hotel_system.h"
+#include <string>
+#include <string_view>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <shared_mutex>
+#include <unordered_map>
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// ==================== STATIC ASSET CACHE ====================
+
+// One file from static/, ready to send. Entries are immutable once built; a reload
+// swaps in a new one, so handlers can keep using the copy they looked up.
+struct Asset {
+    std::string body;
+    std::string gzipBody;     // Empty when compression is unavailable or doesn't pay off
+    std::string contentType;
+    std::string cacheControl;
+    std::string etag;         // Strong validator over the uncompressed bytes
+    std::string gzipEtag;     // Each encoding is a different representation
+};
+
+// Loads every file under the static directory once at startup and serves it from
+// memory with ETag / If-None-Match revalidation. Gzip variants are precomputed when
+// the server is built with CROW_ENABLE_COMPRESSION (zlib); there is no brotli encoder
+// in the build, so no brotli variants. On Linux, watch() reloads files as they change.
+class AssetCache {
+private:
+    std::string root;
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const Asset>> assets;  // Keyed by path under root
+    std::atomic<bool> watching;
+    std::thread watcher;
+
+    static std::string extensionOf(const std::string& path) {
+        size_t dot = path.rfind('.');
+        if (dot == std::string::npos || path.find('/', dot) != std::string::npos) return "";
+        std::string extension = path.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    static const char* contentTypeFor(const std::string& extension) {
+        if (extension == "html") return "text/html";
+        if (extension == "css") return "text/css";
+        if (extension == "js") return "application/javascript";
+        if (extension == "json") return "application/json";
+        if (extension == "png") return "image/png";
+        if (extension == "jpg" || extension == "jpeg") return "image/jpeg";
+        if (extension == "gif") return "image/gif";
+        if (extension == "svg") return "image/svg+xml";
+        if (extension == "ico") return "image/x-icon";
+        return "application/octet-stream";
+    }
+
+    static bool isCompressible(const std::string& contentType) {
+        return contentType.rfind("text/", 0) == 0 || contentType == "application/javascript" ||
+               contentType == "application/json" || contentType == "image/svg+xml";
+    }
+
+    static std::string makeEtag(std::string_view body, const char* suffix) {
+        std::ostringstream etag;
+        etag << '"' << std::hex << std::setw(16) << std::setfill('0') << hashString(body) << suffix << '"';
+        return etag.str();
+    }
+
+    // Returns nullptr if the file can't be read
+    std::shared_ptr<const Asset> build(const std::string& relativePath) const {
+        std::ifstream file(root + "/" + relativePath, std::ios::binary);
+        if (!file.is_open()) return nullptr;
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+
+        auto asset = std::make_shared<Asset>();
+        asset->body = buffer.str();
+        asset->contentType = contentTypeFor(extensionOf(relativePath));
+        // Pages have fixed URLs, so browsers always revalidate them (a cheap 304);
+        // other assets may be reused for an hour without asking
+        asset->cacheControl = (asset->contentType == "text/html") ? "no-cache" : "public, max-age=3600";
+        asset->etag = makeEtag(asset->body, "");
+#ifdef CROW_ENABLE_COMPRESSION
+        if (isCompressible(asset->contentType)) {
+            std::string compressed = crow::compression::compress_string(asset->body, crow::compression::GZIP);
+            if (!compressed.empty() && compressed.size() < asset->body.size()) {
+                asset->gzipBody = std::move(compressed);
+                asset->gzipEtag = makeEtag(asset->body, "-gz");
+            }
+        }
+#endif
+        return asset;
+    }
+
+    void reload(const std::string& relativePath) {
+        std::shared_ptr<const Asset> asset = build(relativePath);
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (asset != nullptr) {
+            assets[relativePath] = asset;
+        } else {
+            assets.erase(relativePath);
+        }
+    }
+
+    // True if any entity tag in the If-None-Match list matches (weak comparison)
+    static bool matchesAny(const std::string& ifNoneMatch, const std::string& etag) {
+        size_t pos = 0;
+        while (pos < ifNoneMatch.size()) {
+            size_t comma = ifNoneMatch.find(',', pos);
+            if (comma == std::string::npos) comma = ifNoneMatch.size();
+            std::string_view tag(ifNoneMatch.data() + pos, comma - pos);
+            while (!tag.empty() && tag.front() == ' ') tag.remove_prefix(1);
+            while (!tag.empty() && tag.back() == ' ') tag.remove_suffix(1);
+            if (tag.substr(0, 2) == "W/") tag.remove_prefix(2);
+            if (tag == "*" || tag == etag) return true;
+            pos = comma + 1;
+        }
+        return false;
+    }
+
+    static bool acceptsGzip(const crow::request& req) {
+        const std::string& accept = req.get_header_value("Accept-Encoding");
+        return accept.find("gzip") != std::string::npos;
+    }
+
+#ifdef __linux__
+    // Only the top level of the static directory is watched, which is all it has
+    void watchLoop(int fd) {
+        alignas(struct inotify_event) char buffer[4096];
+        while (watching) {
+            pollfd waitFor{fd, POLLIN, 0};
+            if (poll(&waitFor, 1, 250) <= 0) continue;
+            ssize_t length = read(fd, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+                if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                    reload(event->name);
+                    std::cout << "Reloaded asset " << event->name << std::endl;
+                }
+                offset += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+public:
+    explicit AssetCache(const std::string& rootDirectory) : root(rootDirectory), watching(false) {}
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    ~AssetCache() {
+        if (watching.exchange(false)) watcher.join();
+    }
+
+    // Reads every regular file under the root; returns how many were cached
+    size_t loadAll() {
+        std::error_code error;
+        std::filesystem::recursive_directory_iterator it(root, error), end;
+        for (; !error && it != end; it.increment(error)) {
+            if (!it->is_regular_file()) continue;
+            std::string relativePath = std::filesystem::relative(it->path(), root).generic_string();
+            reload(relativePath);
+        }
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return assets.size();
+    }
+
+    // Starts reloading changed files in the background; returns false where unsupported
+    bool watch() {
+#ifdef __linux__
+        if (watching) return true;
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) return false;
+        if (inotify_add_watch(fd, root.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM) < 0) {
+            close(fd);
+            return false;
+        }
+        watching = true;
+        watcher = std::thread(&AssetCache::watchLoop, this, fd);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::shared_ptr<const Asset> find(const std::string& relativePath) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = assets.find(relativePath);
+        return (it != assets.end()) ? it->second : nullptr;
+    }
+
+    // 200 with the best encoding the client accepts, 304 if its copy is current, or 404
+    crow::response serve(const crow::request& req, const std::string& relativePath) const {
+        std::shared_ptr<const Asset> asset = find(relativePath);
+        if (asset == nullptr) return crow::response(404, relativePath + " not found");
+
+        bool gzip = !asset->gzipBody.empty() && acceptsGzip(req);
+        const std::string& etag = gzip ? asset->gzipEtag : asset->etag;
+
+        crow::response res;
+        const std::string& ifNoneMatch = req.get_header_value("If-None-Match");
+        if (!ifNoneMatch.empty() && matchesAny(ifNoneMatch, etag)) {
+            res.code = 304;
+        } else {
+            res.body = gzip ? asset->gzipBody : asset->body;
+            res.set_header("Content-Type", asset->contentType);
+            if (gzip) res.set_header("Content-Encoding", "gzip");
+        }
+        res.set_header("ETag", etag);
+        res.set_header("Cache-Control", asset->cacheControl);
+        if (!asset->gzipBody.empty()) res.set_header("Vary", "Accept-Encoding");
+#ifdef CROW_ENABLE_COMPRESSION
+        res.compressed = false;  // Already encoded; don't let Crow compress it again
+#endif
+        return res;
+    }
+};
+
+#endif // ASSET_CACHE_H
@@ -0,0 +1,59 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <string>
+#include <cstdio>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ==================== ATOMIC FILE REPLACEMENT ====================
+
+// Writes `contents` to "<path>.tmp", fsyncs it and renames it over `path`, so a
+// crash leaves either the old file or the complete new one, never a torn mix.
+bool writeFileAtomically(const std::string& path, const std::string& contents) {
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) return false;
+    
+    bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = std::fflush(file) == 0 && ok;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    
+#ifdef _WIN32
+    // std::rename refuses to replace an existing file on Windows
+    return MoveFileExA(tempPath.c_str(), path.c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) return false;
+    
+    // Make the rename itself durable
+    std::string directory = ".";
+    size_t slash = path.rfind('/');
+    if (slash != std::string::npos) directory = path.substr(0, slash);
+    int dirFd = ::open(directory.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+#endif
+}
+
+#endif // ATOMIC_FILE_H
@@ -0,0 +1,327 @@
+#ifndef BINARY_SNAPSHOT_H
+#define BINARY_SNAPSHOT_H
+
+#include "hotel_system.h"
+#include <cstring>
+#include <unordered_map>
+
+// ==================== BINARY SNAPSHOT FORMAT ====================
+
+// Compact alternative to the text .dat files, holding all HotelManager state in one file.
+//
+//   magic "HTLSNAP1" | u32 version | u32 dictionary size | dictionary strings
+//   | rooms | users | bookings | orders | service requests | u64 checksum
+//
+// All integers are little-endian and fixed width. Doubles are stored as their IEEE-754
+// bits, so prices round-trip exactly (the text format keeps six decimals). Strings are
+// u32 length + bytes. Values that repeat across records (room features, roles, guest
+// ids, menu item names) are written once in the dictionary and referenced by u32 index.
+// Enums are stored as their u8 declaration index, so reordering an enum needs a
+// version bump. The checksum is hashString() over every byte before it.
+//
+// Version history: 1 = initial layout; 2 = bookings gain a u8 anyRoomOfType flag.
+// The reader still accepts version 1 files.
+
+struct SnapshotData {
+    std::vector<Room> rooms;
+    std::vector<User> users;
+    std::vector<Booking> bookings;
+    std::vector<FoodOrder> orders;
+    std::vector<ServiceRequest> requests;
+};
+
+class SnapshotWriter {
+private:
+    std::string body;
+    std::vector<std::string> dictionary;
+    std::unordered_map<std::string, uint32_t> dictionaryIndex;
+
+    static void putRaw(std::string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void putU8(uint8_t value) { putRaw(body, value, 1); }
+    void putI32(int value) { putRaw(body, static_cast<uint32_t>(value), 4); }
+    void putU32(uint32_t value) { putRaw(body, value, 4); }
+
+    void putDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putRaw(body, bits, 8);
+    }
+
+    static void putString(std::string& out, const std::string& value) {
+        putRaw(out, static_cast<uint32_t>(value.size()), 4);
+        out += value;
+    }
+
+    void putString(const std::string& value) { putString(body, value); }
+
+    void putShared(const std::string& value) {
+        auto it = dictionaryIndex.find(value);
+        if (it == dictionaryIndex.end()) {
+            it = dictionaryIndex.emplace(value, static_cast<uint32_t>(dictionary.size())).first;
+            dictionary.push_back(value);
+        }
+        putU32(it->second);
+    }
+
+    template<typename Enum>
+    void putEnum(Enum value) { putU8(static_cast<uint8_t>(value)); }
+
+public:
+    static constexpr const char* MAGIC = "HTLSNAP1";
+    static const uint32_t VERSION = 2;
+
+    std::string serialize(const SnapshotData& data) {
+        body.clear();
+        dictionary.clear();
+        dictionaryIndex.clear();
+
+        putU32(static_cast<uint32_t>(data.rooms.size()));
+        for (const auto& room : data.rooms) {
+            putI32(room.roomNumber);
+            putEnum(room.type);
+            putEnum(room.status);
+            putDouble(room.pricePerNight);
+            putI32(room.floor);
+            putShared(room.features);
+        }
+
+        putU32(static_cast<uint32_t>(data.users.size()));
+        for (const auto& user : data.users) {
+            putString(user.userId);
+            putString(user.password);
+            putString(user.name);
+            putString(user.email);
+            putString(user.phone);
+            putShared(user.role);
+        }
+
+        putU32(static_cast<uint32_t>(data.bookings.size()));
+        for (const auto& booking : data.bookings) {
+            putI32(booking.bookingId);
+            putShared(booking.userId);
+            putI32(booking.roomNumber);
+            putString(booking.checkInDate);
+            putString(booking.checkOutDate);
+            putI32(booking.nights);
+            putDouble(booking.totalAmount);
+            putEnum(booking.status);
+            putString(booking.bookingDate);
+            putU8(booking.anyRoomOfType ? 1 : 0);
+        }
+
+        putU32(static_cast<uint32_t>(data.orders.size()));
+        for (const auto& order : data.orders) {
+            putI32(order.orderId);
+            putShared(order.userId);
+            putI32(order.roomNumber);
+            putU32(static_cast<uint32_t>(order.items.size()));
+            for (const auto& item : order.items) {
+                putShared(item.first);
+                putI32(item.second);
+            }
+            putDouble(order.totalPrice);
+            putEnum(order.status);
+            putString(order.orderTime);
+        }
+
+        putU32(static_cast<uint32_t>(data.requests.size()));
+        for (const auto& request : data.requests) {
+            putI32(request.requestId);
+            putI32(request.roomNumber);
+            putEnum(request.type);
+            putString(request.description);
+            putI32(request.priority);
+            putEnum(request.status);
+            putString(request.requestTime);
+            putString(request.assignedTo);
+        }
+
+        std::string out(MAGIC);
+        putRaw(out, VERSION, 4);
+        putRaw(out, static_cast<uint32_t>(dictionary.size()), 4);
+        for (const auto& value : dictionary) {
+            putString(out, value);
+        }
+        out += body;
+        putRaw(out, hashString(out), 8);
+        return out;
+    }
+};
+
+// Every get*() is bounds checked; after the first failure `ok` stays false and the
+// remaining reads return zero values, so a truncated file is reported, not trusted.
+class SnapshotReader {
+private:
+    const char* cursor;
+    const char* end;
+    bool ok;
+    std::vector<std::string> dictionary;
+
+    uint64_t getRaw(int bytes) {
+        if (!ok || end - cursor < bytes) {
+            ok = false;
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(cursor[i])) << (8 * i);
+        }
+        cursor += bytes;
+        return value;
+    }
+
+    uint8_t getU8() { return static_cast<uint8_t>(getRaw(1)); }
+    int getI32() { return static_cast<int>(static_cast<uint32_t>(getRaw(4))); }
+    uint32_t getU32() { return static_cast<uint32_t>(getRaw(4)); }
+
+    double getDouble() {
+        uint64_t bits = getRaw(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string getString() {
+        uint32_t length = getU32();
+        if (!ok || static_cast<size_t>(end - cursor) < length) {
+            ok = false;
+            return std::string();
+        }
+        std::string value(cursor, length);
+        cursor += length;
+        return value;
+    }
+
+    const std::string& getShared() {
+        static const std::string empty;
+        uint32_t index = getU32();
+        if (!ok || index >= dictionary.size()) {
+            ok = false;
+            return empty;
+        }
+        return dictionary[index];
+    }
+
+    template<typename Enum>
+    Enum getEnum(int count) {
+        uint8_t value = getU8();
+        if (value >= count) ok = false;
+        return ok ? static_cast<Enum>(value) : Enum();
+    }
+
+    // Element counts are checked against the bytes left so a corrupt count cannot
+    // trigger a huge allocation
+    uint32_t getCount(size_t minRecordBytes) {
+        uint32_t count = getU32();
+        if (ok && count > static_cast<size_t>(end - cursor) / minRecordBytes) ok = false;
+        return ok ? count : 0;
+    }
+
+public:
+    SnapshotReader() : cursor(nullptr), end(nullptr), ok(false) {}
+
+    // Returns false (leaving `data` partially filled) on a bad magic, version or checksum
+    bool read(std::string_view file, SnapshotData& data, std::string& error) {
+        size_t magicLength = std::strlen(SnapshotWriter::MAGIC);
+        if (file.size() < magicLength + 16 || file.compare(0, magicLength, SnapshotWriter::MAGIC) != 0) {
+            error = "not a hotel snapshot";
+            return false;
+        }
+
+        cursor = file.data() + file.size() - 8;
+        end = file.data() + file.size();
+        ok = true;
+        uint64_t checksum = getRaw(8);
+        if (checksum != hashString(file.substr(0, file.size() - 8))) {
+            error = "checksum mismatch";
+            return false;
+        }
+
+        cursor = file.data() + magicLength;
+        end = file.data() + file.size() - 8;
+        uint32_t version = getU32();
+        if (version < 1 || version > SnapshotWriter::VERSION) {
+            error = "unsupported snapshot version " + std::to_string(version);
+            return false;
+        }
+
+        dictionary.resize(getCount(4));
+        for (auto& value : dictionary) {
+            value = getString();
+        }
+
+        data.rooms.resize(getCount(22));
+        for (auto& room : data.rooms) {
+            room.roomNumber = getI32();
+            room.type = getEnum<RoomType>(ROOM_TYPE_COUNT);
+            room.status = getEnum<RoomStatus>(ROOM_STATUS_COUNT);
+            room.pricePerNight = getDouble();
+            room.floor = getI32();
+            room.features = getShared();
+        }
+
+        data.users.resize(getCount(24));
+        for (auto& user : data.users) {
+            user.userId = getString();
+            user.password = getString();
+            user.name = getString();
+            user.email = getString();
+            user.phone = getString();
+            user.role = getShared();
+        }
+
+        data.bookings.resize(getCount(37));
+        for (auto& booking : data.bookings) {
+            booking.bookingId = getI32();
+            booking.userId = getShared();
+            booking.roomNumber = getI32();
+            booking.checkInDate = getString();
+            booking.checkOutDate = getString();
+            booking.nights = getI32();
+            booking.totalAmount = getDouble();
+            booking.status = getEnum<BookingStatus>(BOOKING_STATUS_COUNT);
+            booking.bookingDate = getString();
+            booking.anyRoomOfType = (version >= 2) && getU8() != 0;
+        }
+
+        data.orders.resize(getCount(29));
+        for (auto& order : data.orders) {
+            order.orderId = getI32();
+            order.userId = getShared();
+            order.roomNumber = getI32();
+            order.items.resize(getCount(8));
+            for (auto& item : order.items) {
+                item.first = getShared();
+                item.second = getI32();
+            }
+            order.totalPrice = getDouble();
+            order.status = getEnum<OrderStatus>(ORDER_STATUS_COUNT);
+            order.orderTime = getString();
+        }
+
+        data.requests.resize(getCount(26));
+        for (auto& request : data.requests) {
+            request.requestId = getI32();
+            request.roomNumber = getI32();
+            request.type = getEnum<ServiceType>(SERVICE_TYPE_COUNT);
+            request.description = getString();
+            request.priority = getI32();
+            request.status = getEnum<ServiceStatus>(SERVICE_STATUS_COUNT);
+            request.requestTime = getString();
+            request.assignedTo = getString();
+        }
+
+        if (!ok || cursor != end) {
+            error = "truncated or malformed snapshot";
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // BINARY_SNAPSHOT_H
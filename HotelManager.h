@@ -2,16 +2,237 @@
 #define HOTEL_MANAGER_H
 
 #include "hotel_system.h"
+#include "Journal.h"
+#include "MappedFile.h"
+#include "BinarySnapshot.h"
+#include "AtomicFile.h"
 #include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <filesystem>
+#include <stdexcept>
+
+// On-disk format for full snapshots; the journal is text either way
+enum class SnapshotFormat { Text, Binary };
+
+// ?limit=&cursor= of a list endpoint. The cursor is the id (userId for users) of the
+// last record on the previous page; responses carry "nextCursor" while more remain.
+struct PageQuery {
+    int limit = 0;              // 0 = no limit
+    std::string cursor;         // Empty = from the start
+    bool newestFirst = false;   // Walk back from the newest record; the cursor means "before"
+};
 
 class HotelManager {
 private:
-    RoomBST roomTree;
+    RoomIndex roomIndex;
     HashTable<User> userTable;
-    LinkedList<Booking> bookingList;
-    LinkedList<FoodOrder> foodOrderList;
+    RecordLog<Booking> bookingLog;
+    RecordLog<FoodOrder> foodOrderLog;
     std::priority_queue<ServiceRequest> serviceRequestQueue;
-    std::queue<Booking> waitingQueue;  // For when rooms are full
+    std::unordered_set<int> serviceRequestIds;  // Lets journal replay skip requests already queued
+    Waitlist waitlist;  // Waiting bookings (stored in bookingLog) by room/type, oldest first
+    IdAllocator bookingIds;
+    IdAllocator orderIds;
+    IdAllocator requestIds;
+    
+    // Dashboard aggregates over bookingLog, kept in step with every booking that is
+    // added or changes status (under bookingMutex) so the stats endpoint never scans.
+    // Room counts come straight from RoomIndex's per-status sets.
+    struct BookingTotals {
+        int active = 0;        // Checked in
+        double revenue = 0.0;  // Sum over checked-out stays
+        
+        void apply(const Booking& booking, int sign) {
+            if (booking.status == BookingStatus::CheckedIn) active += sign;
+            if (booking.status == BookingStatus::CheckedOut) revenue += sign * booking.totalAmount;
+        }
+    };
+    BookingTotals bookingTotals;
+    
+    // Nights held by Confirmed and CheckedIn bookings; guarded by roomMutex. Room
+    // status (other than Maintenance) is derived from it.
+    ReservationCalendar calendar;
+    
+    // Crow runs handlers on several worker threads, so every aggregate has its own
+    // reader/writer lock. Read-only endpoints take shared locks and scale across workers.
+    // When more than one is needed they are always acquired in this order:
+    //   users -> bookings -> orders -> rooms -> service requests
+    mutable std::shared_mutex userMutex;
+    mutable std::shared_mutex bookingMutex;   // bookingLog + waitlist
+    mutable std::shared_mutex orderMutex;
+    mutable std::shared_mutex roomMutex;
+    mutable std::shared_mutex serviceMutex;
+    
+    using ReadLock = std::shared_lock<std::shared_mutex>;
+    using WriteLock = std::unique_lock<std::shared_mutex>;
+    
+    // State transitions shared by several operations; callers hold the matching write lock
+    bool setRoomStatus(int roomNumber, RoomStatus status) {
+        if (!roomIndex.updateRoomStatus(roomNumber, status)) return false;
+        journal.append("ROOM_STATUS", std::to_string(roomNumber) + "|" + toString(status));
+        return true;
+    }
+    
+    void setBookingStatus(Booking& booking, BookingStatus status) {
+        bookingTotals.apply(booking, -1);
+        booking.status = status;
+        bookingTotals.apply(booking, +1);
+        journal.append("BOOKING_STATUS", std::to_string(booking.bookingId) + "|" + toString(status));
+    }
+    
+    static bool stayOf(const Booking& booking, int& from, int& to) {
+        return parseDate(booking.checkInDate, from) && parseDate(booking.checkOutDate, to) && from < to;
+    }
+    
+    // Callers hold the room write lock. Maintenance is a manual state and is left alone.
+    void refreshRoomStatus(int roomNumber) {
+        const Room* room = roomIndex.search(roomNumber);
+        if (room == nullptr || room->status == RoomStatus::Maintenance) return;
+        RoomStatus status = calendar.derivedStatus(roomNumber);
+        if (room->status != status) setRoomStatus(roomNumber, status);
+    }
+    
+    // Frees the booking's nights; callers hold the booking and room write locks
+    void releaseStay(const Booking& booking) {
+        int from, to;
+        if (stayOf(booking, from, to)) calendar.release(booking.roomNumber, from, booking.bookingId);
+        refreshRoomStatus(booking.roomNumber);
+    }
+    
+    // Confirms waiting bookings that now fit room `roomNumber`: those waiting for it
+    // first, then those happy with any room of its type, oldest first. Waiters whose
+    // nights still clash keep their place. When only the nights [freedFrom, freedTo)
+    // were freed the walk stops once they are all taken again, since no later waiter
+    // can fit then. Returns how many were promoted.
+    // Callers hold the booking and room write locks.
+    int promoteWaiting(int roomNumber, int freedFrom = std::numeric_limits<int>::min(),
+                       int freedTo = std::numeric_limits<int>::max()) {
+        const Room* room = roomIndex.search(roomNumber);
+        if (room == nullptr || room->status == RoomStatus::Maintenance) return 0;
+        
+        int promoted = 0;
+        long long freeNights = (long long)freedTo - freedFrom;
+        auto tryPromote = [&](int bookingId) {
+            Booking* booking = bookingLog.find(bookingId);
+            int from, to;
+            if (booking == nullptr || booking->status != BookingStatus::Waiting || !stayOf(*booking, from, to)) {
+                waitlist.remove(bookingId);  // Stale entry
+                return true;
+            }
+            if (!calendar.reserve(roomNumber, from, to, bookingId)) return true;
+            
+            waitlist.remove(bookingId);
+            bookingTotals.apply(*booking, -1);
+            booking->roomNumber = roomNumber;
+            booking->totalAmount = room->pricePerNight * (to - from);
+            booking->status = BookingStatus::Confirmed;
+            bookingTotals.apply(*booking, +1);
+            journal.append("BOOKING", booking->toFileString());
+            promoted++;
+            
+            freeNights -= std::max(0, std::min(to, freedTo) - std::max(from, freedFrom));
+            return freeNights > 0;
+        };
+        if (freeNights > 0 && waitlist.forEachWaitingForRoom(roomNumber, tryPromote)) {
+            waitlist.forEachWaitingForType(room->type, tryPromote);
+        }
+        
+        if (promoted > 0) refreshRoomStatus(roomNumber);
+        return promoted;
+    }
+    
+    // Promotes waiters into the nights `booking` just gave up
+    int promoteIntoStay(const Booking& booking) {
+        int from, to;
+        return stayOf(booking, from, to) ? promoteWaiting(booking.roomNumber, from, to)
+                                         : promoteWaiting(booking.roomNumber);
+    }
+    
+    // Reserves [from, to) in `roomNumber` or, with anyRoomOfType, in the cheapest room
+    // of its type that is free, setting roomNumber to the room taken. Callers hold at
+    // least the room read lock.
+    bool claimStay(int& roomNumber, int from, int to, int bookingId, bool anyRoomOfType) {
+        const Room* room = roomIndex.search(roomNumber);
+        if (room == nullptr) return false;
+        if (room->status != RoomStatus::Maintenance && calendar.reserve(roomNumber, from, to, bookingId)) {
+            return true;
+        }
+        if (!anyRoomOfType) return false;
+        
+        bool claimed = false;
+        roomIndex.forEachByPrice(room->type, std::numeric_limits<double>::max(), [&](const Room& candidate) {
+            if (candidate.status == RoomStatus::Maintenance ||
+                !calendar.reserve(candidate.roomNumber, from, to, bookingId)) {
+                return true;
+            }
+            roomNumber = candidate.roomNumber;
+            claimed = true;
+            return false;
+        });
+        return claimed;
+    }
+    
+    void enqueueWaiting(const Booking& booking) {
+        const Room* room = roomIndex.search(booking.roomNumber);
+        if (booking.anyRoomOfType && room != nullptr) {
+            waitlist.addForType(room->type, booking.bookingId);
+        } else {
+            waitlist.addForRoom(booking.roomNumber, booking.bookingId);
+        }
+    }
+    
+    // Writes `"<name>":[...]` with one page of `log`, plus "nextCursor" if more remain.
+    // `visit(start, fn)` walks the records from a log position, forward or (for
+    // newest-first pages) backward. Returns false, writing nothing, for a cursor that
+    // names no record. Callers hold the log's lock.
+    template<typename T, typename Visit>
+    bool writePage(JsonWriter& json, const char* name, RecordLog<T>& log, const PageQuery& page,
+                   size_t recordBytes, Visit visit) {
+        int start = page.newestFirst ? log.endPosition() - 1 : 0;
+        if (!page.cursor.empty()) {
+            int id = 0;
+            const char* end = page.cursor.data() + page.cursor.size();
+            auto result = std::from_chars(page.cursor.data(), end, id);
+            if (result.ec != std::errc() || result.ptr != end) return false;
+            int position = log.positionOf(id);
+            if (position < 0) return false;
+            start = page.newestFirst ? position - 1 : position + 1;
+        }
+        
+        size_t expected = log.getSize();
+        if (page.limit > 0) expected = std::min(expected, static_cast<size_t>(page.limit));
+        json.reserve(expected * recordBytes);
+        
+        int written = 0;
+        int lastId = 0;
+        bool more = false;
+        json.key(name);
+        json.beginArray();
+        visit(start, [&](const T& record) {
+            if (page.limit > 0 && written == page.limit) {
+                more = true;
+                return false;
+            }
+            record.writeJSON(json);
+            lastId = RecordLog<T>::getIdFromData(record);
+            written++;
+            return true;
+        });
+        json.endArray();
+        if (more) {
+            json.key("nextCursor");
+            json.value(std::to_string(lastId));
+        }
+        return true;
+    }
     
     // File paths
     const std::string ROOMS_FILE = "data/rooms.dat";
@@ -19,52 +240,88 @@ private:
     const std::string BOOKINGS_FILE = "data/bookings.dat";
     const std::string ORDERS_FILE = "data/orders.dat";
     const std::string REQUESTS_FILE = "data/requests.dat";
+    const std::string JOURNAL_FILE = "data/journal.log";
+    const std::string SNAPSHOT_FILE = "data/hotel.snap";
+    // Names the format of the last complete snapshot. The other format's files may be
+    // older, so loading never guesses between them.
+    const std::string FORMAT_FILE = "data/snapshot.format";
+    SnapshotFormat snapshotFormat;  // Format new snapshots are written in
+    
+    // Mutations since the last snapshot; folded into a new one when the policy trips
+    Journal journal;
+    const std::chrono::milliseconds JOURNAL_SYNC_INTERVAL{20};
+    std::future<void> pendingSnapshot;  // Background write of the latest snapshot
     
 public:
-    HotelManager() {
+    // Throws std::runtime_error if the saved state can't be loaded safely
+    explicit HotelManager(SnapshotFormat format = SnapshotFormat::Text,
+                          const CompactionPolicy& compaction = CompactionPolicy())
+        : snapshotFormat(format) {
         loadAllData();
-        initializeDefaultData();
+        replayJournal();
+        bool createdDefaults = initializeDefaultData();  // Before the calendar, which registers every room
+        recoverIds();
+        rebuildCalendar();
+        bookingTotals = computeBookingTotals();
+        // The defaults are never journaled, so save them before any journaled change
+        // can make the room index non-empty and stop them being recreated
+        if (createdDefaults && !writeSnapshot(collectSnapshot(), snapshotFormat)) {
+            throw std::runtime_error("can't save the default rooms and users");
+        }
+        if (!journal.open(JOURNAL_FILE, compaction, JOURNAL_SYNC_INTERVAL,
+                          [this]() { takeSnapshot(); })) {
+            throw std::runtime_error("can't open " + JOURNAL_FILE + " for writing");
+        }
     }
     
+    // Everything is already in the journal, so shutdown only has to sync it and let
+    // an in-flight snapshot finish
     ~HotelManager() {
-        saveAllData();
+        journal.close();
+        if (pendingSnapshot.valid()) pendingSnapshot.wait();
     }
     
     // ==================== INITIALIZATION ====================
     
-    void initializeDefaultData() {
+    // Returns whether anything was created
+    bool initializeDefaultData() {
+        bool created = false;
+        
         // Check if users exist, if not create defaults
         if (userTable.search("user") == nullptr) {
+            created = true;
             userTable.insert("user", User("user", "1234", "Guest User", "user@hotel.com", "1234567890", "user"));
             userTable.insert("admin", User("admin", "admin123", "Admin", "admin@hotel.com", "9876543210", "admin"));
             userTable.insert("staff", User("staff", "staff123", "Staff Member", "staff@hotel.com", "5555555555", "staff"));
         }
         
         // Initialize rooms if empty
-        auto rooms = roomTree.getAllRooms();
-        if (rooms.empty()) {
+        if (roomIndex.size() == 0) {
+            created = true;
             // Single rooms (101-110)
             for (int i = 101; i <= 110; i++) {
-                roomTree.insert(Room(i, "Single", 1500.0, "Available", 1, "AC, TV, WiFi"));
+                roomIndex.insert(Room(i, RoomType::Single, 1500.0, RoomStatus::Available, 1, "AC, TV, WiFi"));
             }
             // Double rooms (201-210)
             for (int i = 201; i <= 210; i++) {
-                roomTree.insert(Room(i, "Double", 2500.0, "Available", 2, "AC, TV, WiFi, Mini-bar"));
+                roomIndex.insert(Room(i, RoomType::Double, 2500.0, RoomStatus::Available, 2, "AC, TV, WiFi, Mini-bar"));
             }
             // Suite rooms (301-305)
             for (int i = 301; i <= 305; i++) {
-                roomTree.insert(Room(i, "Suite", 5000.0, "Available", 3, "AC, TV, WiFi, Mini-bar, Jacuzzi"));
+                roomIndex.insert(Room(i, RoomType::Suite, 5000.0, RoomStatus::Available, 3, "AC, TV, WiFi, Mini-bar, Jacuzzi"));
             }
             // Deluxe rooms (401-403)
             for (int i = 401; i <= 403; i++) {
-                roomTree.insert(Room(i, "Deluxe", 8000.0, "Available", 4, "AC, TV, WiFi, Mini-bar, Jacuzzi, Ocean View"));
+                roomIndex.insert(Room(i, RoomType::Deluxe, 8000.0, RoomStatus::Available, 4, "AC, TV, WiFi, Mini-bar, Jacuzzi, Ocean View"));
             }
         }
+        return created;
     }
     
     // ==================== USER AUTHENTICATION ====================
     
     crow::json::wvalue login(const std::string& userId, const std::string& password) {
+        ReadLock lock(userMutex);
         User* user = userTable.search(userId);
         crow::json::wvalue response;
         
@@ -94,6 +351,14 @@ public:
             return response;
         }
         
+        for (const std::string* field : {&userId, &password, &name, &email, &phone, &role}) {
+            if (hasControlCharacters(*field)) {
+                response["success"] = false;
+                response["message"] = "Fields can't contain control characters";
+                return response;
+            }
+        }
+        
         if (userId.length() < 3) {
             response["success"] = false;
             response["message"] = "Username must be at least 3 characters";
@@ -106,6 +371,8 @@ public:
             return response;
         }
         
+        WriteLock lock(userMutex);
+        
         // Check if user already exists
         if (userTable.search(userId) != nullptr) {
             response["success"] = false;
@@ -116,6 +383,7 @@ public:
         // Create and insert user
         User newUser(userId, password, name, email, phone, role);
         userTable.insert(userId, newUser);
+        journal.append("USER", newUser.toFileString());
         
         response["success"] = true;
         response["message"] = "Registration successful! You can now login.";
@@ -125,28 +393,69 @@ public:
     }
     
     // Get all users (for admin)
-    std::vector<crow::json::wvalue> getAllUsers() {
-        auto users = userTable.getAllValues();
-        std::vector<crow::json::wvalue> jsonUsers;
-        
-        for (const auto& user : users) {
-            jsonUsers.push_back(user.toJSON());
+    // Without paging users come in table order. The table has no order of its own, so
+    // pages are cut by userId instead: one pass collects the users after the cursor and
+    // a partial sort picks the first `limit` of them. Newest-first pages go by
+    // descending userId.
+    void writeUsers(JsonWriter& json, const PageQuery& page) {
+        ReadLock lock(userMutex);
+        json.key("users");
+        json.beginArray();
+        if (page.limit == 0 && page.cursor.empty() && !page.newestFirst) {
+            userTable.forEach([&](const User& user) { user.writeJSON(json); });
+            json.endArray();
+            return;
         }
         
-        return jsonUsers;
+        std::vector<const User*> candidates;
+        userTable.forEach([&](const User& user) {
+            bool next = page.newestFirst ? (page.cursor.empty() || user.userId < page.cursor)
+                                         : user.userId > page.cursor;
+            if (next) candidates.push_back(&user);
+        });
+        size_t count = candidates.size();
+        if (page.limit > 0) count = std::min(count, static_cast<size_t>(page.limit));
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                          [&](const User* a, const User* b) {
+            return page.newestFirst ? a->userId > b->userId : a->userId < b->userId;
+        });
+        for (size_t i = 0; i < count; i++) {
+            candidates[i]->writeJSON(json);
+        }
+        json.endArray();
+        if (count < candidates.size()) {
+            json.key("nextCursor");
+            json.value(candidates[count - 1]->userId);
+        }
     }
     
     // Delete user (admin only)
     bool deleteUser(const std::string& userId) {
         // Don't allow deleting admin account
         if (userId == "admin") return false;
-        return userTable.remove(userId);
+        WriteLock lock(userMutex);
+        if (!userTable.remove(userId)) return false;
+        journal.append("USER_DELETE", userId);
+        return true;
     }
     
     // ==================== ROOM MANAGEMENT ====================
     
-    std::vector<crow::json::wvalue> getAllRooms() {
-        auto rooms = roomTree.getAllRooms();
+    // Writes `"rooms":[...]` with every room straight into the writer's buffer
+    void writeAllRooms(JsonWriter& json) {
+        ReadLock lock(roomMutex);
+        json.reserve(roomIndex.size() * 128);
+        json.key("rooms");
+        json.beginArray();
+        roomIndex.forEach([&](const Room& room) {
+            room.writeJSON(json);
+        });
+        json.endArray();
+    }
+    
+    std::vector<crow::json::wvalue> getAvailableRooms() {
+        ReadLock lock(roomMutex);
+        auto rooms = roomIndex.getRoomsByStatus(RoomStatus::Available);
         std::vector<crow::json::wvalue> jsonRooms;
         for (const auto& room : rooms) {
             jsonRooms.push_back(room.toJSON());
@@ -154,28 +463,83 @@ public:
         return jsonRooms;
     }
     
-    std::vector<crow::json::wvalue> getAvailableRooms() {
-        auto rooms = roomTree.getRoomsByStatus("Available");
+    // Up to `limit` bookable rooms for [from, to), cheapest first. Each candidate type
+    // is walked along its price index and stops after `limit` free rooms or at
+    // maxPrice, so only rooms cheaper than the answer that are booked get skipped
+    // over; the per-type results are then merged by price.
+    std::vector<crow::json::wvalue> searchRooms(const std::vector<RoomType>& types, int from, int to,
+                                                double maxPrice, int limit) {
+        ReadLock lock(roomMutex);
+        std::vector<const Room*> matches;
+        for (RoomType type : types) {
+            int found = 0;
+            roomIndex.forEachByPrice(type, maxPrice, [&](const Room& room) {
+                if (room.status != RoomStatus::Maintenance && calendar.isFree(room.roomNumber, from, to)) {
+                    matches.push_back(&room);
+                    found++;
+                }
+                return found < limit;
+            });
+        }
+        
+        std::sort(matches.begin(), matches.end(), [](const Room* a, const Room* b) {
+            if (a->pricePerNight != b->pricePerNight) return a->pricePerNight < b->pricePerNight;
+            return a->roomNumber < b->roomNumber;
+        });
+        if ((int)matches.size() > limit) matches.resize(limit);
+        
         std::vector<crow::json::wvalue> jsonRooms;
-        for (const auto& room : rooms) {
-            jsonRooms.push_back(room.toJSON());
+        for (const Room* room : matches) {
+            crow::json::wvalue json = room->toJSON();
+            json["capacity"] = capacityOf(room->type);
+            json["nights"] = to - from;
+            json["totalAmount"] = room->pricePerNight * (to - from);
+            jsonRooms.push_back(std::move(json));
+        }
+        return jsonRooms;
+    }
+    
+    // Rooms of the given types that can be booked for every night in [from, to),
+    // whatever their current status (a Reserved room may be free on other dates);
+    // Maintenance excluded. Only the requested types' rooms are visited, each with
+    // one calendar lookup, so the cost is O(rooms of those types * log stays).
+    std::vector<crow::json::wvalue> getAvailableRooms(int from, int to, const std::vector<RoomType>& types) {
+        ReadLock lock(roomMutex);
+        std::vector<const Room*> matches;
+        for (RoomType type : types) {
+            roomIndex.forEachOfType(type, [&](const Room& room) {
+                if (room.status != RoomStatus::Maintenance && calendar.isFree(room.roomNumber, from, to)) {
+                    matches.push_back(&room);
+                }
+            });
+        }
+        if (types.size() > 1) {
+            std::sort(matches.begin(), matches.end(),
+                      [](const Room* a, const Room* b) { return a->roomNumber < b->roomNumber; });
+        }
+        
+        std::vector<crow::json::wvalue> jsonRooms;
+        for (const Room* room : matches) {
+            jsonRooms.push_back(room->toJSON());
         }
         return jsonRooms;
     }
     
     std::vector<crow::json::wvalue> getRoomsByType(const std::string& type) {
-        auto rooms = roomTree.getRoomsByType(type);
+        ReadLock lock(roomMutex);
         std::vector<crow::json::wvalue> jsonRooms;
+        RoomType roomType;
+        if (!parse(type, roomType)) return jsonRooms;
+        auto rooms = roomIndex.getRoomsByTypeAndStatus(roomType, RoomStatus::Available);
         for (const auto& room : rooms) {
-            if (room.status == "Available") {
-                jsonRooms.push_back(room.toJSON());
-            }
+            jsonRooms.push_back(room.toJSON());
         }
         return jsonRooms;
     }
     
     crow::json::wvalue getRoomDetails(int roomNumber) {
-        Room* room = roomTree.search(roomNumber);
+        ReadLock lock(roomMutex);
+        const Room* room = roomIndex.search(roomNumber);
         if (room != nullptr) {
             return room->toJSON();
         }
@@ -185,137 +549,208 @@ public:
     }
     
     bool addRoom(const Room& room) {
-        if (roomTree.search(room.roomNumber) != nullptr) {
+        WriteLock bookingLock(bookingMutex);
+        WriteLock lock(roomMutex);
+        if (roomIndex.search(room.roomNumber) != nullptr) {
             return false;  // Room already exists
         }
-        roomTree.insert(room);
+        roomIndex.insert(room);
+        calendar.addRoom(room.roomNumber);
+        journal.append("ROOM", room.toFileString());
+        refreshRoomStatus(room.roomNumber);
+        promoteWaiting(room.roomNumber);
         return true;
     }
     
     bool updateRoom(int roomNumber, const Room& updatedRoom) {
-        Room* room = roomTree.search(roomNumber);
-        if (room != nullptr) {
-            *room = updatedRoom;
-            return true;
-        }
-        return false;
+        WriteLock bookingLock(bookingMutex);
+        WriteLock lock(roomMutex);
+        if (!roomIndex.update(roomNumber, updatedRoom)) return false;
+        journal.append("ROOM", roomIndex.search(roomNumber)->toFileString());
+        refreshRoomStatus(roomNumber);
+        promoteWaiting(roomNumber);
+        return true;
     }
     
+    // Bookings still waiting for the room are cancelled, since it will never free up
     bool deleteRoom(int roomNumber) {
-        Room* room = roomTree.search(roomNumber);
-        if (room != nullptr && room->status == "Available") {
-            roomTree.deleteRoom(roomNumber);
+        WriteLock bookingLock(bookingMutex);
+        WriteLock lock(roomMutex);
+        const Room* room = roomIndex.search(roomNumber);
+        // A stay claimed but not yet published leaves the status Available for a moment
+        if (room != nullptr && room->status == RoomStatus::Available &&
+            calendar.derivedStatus(roomNumber) == RoomStatus::Available) {
+            for (int bookingId : waitlist.dropRoom(roomNumber)) {
+                Booking* booking = bookingLog.find(bookingId);
+                if (booking != nullptr && booking->status == BookingStatus::Waiting) {
+                    setBookingStatus(*booking, BookingStatus::Cancelled);
+                }
+            }
+            roomIndex.deleteRoom(roomNumber);
+            calendar.removeRoom(roomNumber);
+            journal.append("ROOM_DELETE", std::to_string(roomNumber));
             return true;
         }
         return false;
     }
     
-    bool updateRoomStatus(int roomNumber, const std::string& status) {
-        return roomTree.updateRoomStatus(roomNumber, status);
+    // Only Maintenance sticks; any other status is re-derived from the calendar
+    bool updateRoomStatus(int roomNumber, RoomStatus status) {
+        WriteLock bookingLock(bookingMutex);
+        WriteLock lock(roomMutex);
+        if (!setRoomStatus(roomNumber, status)) return false;
+        refreshRoomStatus(roomNumber);
+        promoteWaiting(roomNumber);
+        return true;
     }
     
     // ==================== BOOKING MANAGEMENT ====================
     
+    // A room that can't take the stay puts the booking on a waitlist instead: the
+    // room's own, or with anyRoomOfType its type's. It is confirmed automatically
+    // once a checkout, cancellation or end of maintenance makes room for it.
     crow::json::wvalue createBooking(const std::string& userId, int roomNumber, 
                                       const std::string& checkIn, const std::string& checkOut, 
-                                      int nights) {
+                                      int nights, bool anyRoomOfType = false) {
         crow::json::wvalue response;
         
-        Room* room = roomTree.search(roomNumber);
+        int from, to;
+        if (!parseDate(checkIn, from) || !parseDate(checkOut, to) || from >= to) {
+            response["success"] = false;
+            response["message"] = "Invalid dates: expected YYYY-MM-DD with check-out after check-in";
+            return response;
+        }
+        nights = to - from;
+        if (hasControlCharacters(userId)) {
+            response["success"] = false;
+            response["message"] = "User ID can't contain control characters";
+            return response;
+        }
+        
+        int bookingId = bookingIds.allocate();
+        int requestedRoom = roomNumber;
+        
+        // Claim the nights holding only the shared room lock. Contending claims on a
+        // room are ordered by that room's own lock in the calendar, so the winner is
+        // decided without the aggregate write locks. Appending the booking, journaling
+        // it and updating the room status still need them, so every booking is
+        // serialized for that (short) second step.
+        bool claimed;
+        {
+            ReadLock roomLock(roomMutex);
+            if (roomIndex.search(roomNumber) == nullptr) {
+                response["success"] = false;
+                response["message"] = "Room not found";
+                return response;
+            }
+            claimed = claimStay(roomNumber, from, to, bookingId, anyRoomOfType);
+        }
+        
+        WriteLock bookingLock(bookingMutex);
+        WriteLock roomLock(roomMutex);
+        // The claimed room may have gone into Maintenance in between; give it back and
+        // try again as if the claim had failed
+        if (claimed) {
+            const Room* claimedRoom = roomIndex.search(roomNumber);
+            if (claimedRoom != nullptr && claimedRoom->status == RoomStatus::Maintenance) {
+                calendar.release(roomNumber, from, bookingId);
+                roomNumber = requestedRoom;
+                claimed = false;
+            }
+        }
+        // Nights released since the failed claim may fit after all
+        if (!claimed) claimed = claimStay(roomNumber, from, to, bookingId, anyRoomOfType);
+        const Room* room = roomIndex.search(roomNumber);
         if (room == nullptr) {
             response["success"] = false;
             response["message"] = "Room not found";
             return response;
         }
         
-        if (room->status != "Available") {
-            response["success"] = false;
-            response["message"] = "Room not available";
+        if (!claimed) {
+            Booking waitingBooking(bookingId, userId, roomNumber, checkIn, checkOut, 
+                                  nights, room->pricePerNight * nights, BookingStatus::Waiting, 
+                                  getCurrentDateTime(), anyRoomOfType);
+            bookingLog.append(waitingBooking);
+            journal.append("BOOKING", waitingBooking.toFileString());
+            enqueueWaiting(waitingBooking);
             
-            // Add to waiting queue
-            Booking waitingBooking(generateID(), userId, roomNumber, checkIn, checkOut, 
-                                  nights, room->pricePerNight * nights, "Waiting", 
-                                  getCurrentDateTime());
-            waitingQueue.push(waitingBooking);
-            response["waitingPosition"] = (int)waitingQueue.size();
+            response["success"] = false;
+            response["message"] = "Room not available; added to the waitlist";
+            response["bookingId"] = bookingId;
+            response["waitingPosition"] = waitlist.position(bookingId);
             return response;
         }
         
         // Create booking
-        int bookingId = generateID();
         double totalAmount = room->pricePerNight * nights;
         Booking booking(bookingId, userId, roomNumber, checkIn, checkOut, nights, 
-                       totalAmount, "Confirmed", getCurrentDateTime());
+                       totalAmount, BookingStatus::Confirmed, getCurrentDateTime());
         
-        bookingList.append(booking);
-        roomTree.updateRoomStatus(roomNumber, "Reserved");
+        bookingTotals.apply(bookingLog.append(booking), +1);
+        journal.append("BOOKING", booking.toFileString());
+        refreshRoomStatus(roomNumber);
         
         response["success"] = true;
         response["bookingId"] = bookingId;
+        response["roomNumber"] = roomNumber;
         response["totalAmount"] = totalAmount;
         response["message"] = "Booking confirmed successfully";
         
         return response;
     }
     
-    std::vector<crow::json::wvalue> getUserBookings(const std::string& userId) {
-        auto bookings = bookingList.toVector();
-        std::vector<crow::json::wvalue> userBookings;
-        
-        for (const auto& booking : bookings) {
-            if (booking.userId == userId) {
-                userBookings.push_back(booking.toJSON());
+    bool writeUserBookings(JsonWriter& json, const std::string& userId, const PageQuery& page) {
+        ReadLock lock(bookingMutex);
+        return writePage(json, "bookings", bookingLog, page, 0, [&](int start, auto fn) {
+            if (page.newestFirst) {
+                bookingLog.forEachByUserBackFrom(userId, start, fn);
+            } else {
+                bookingLog.forEachByUserFrom(userId, start, fn);
             }
-        }
-        
-        return userBookings;
+        });
     }
     
-    std::vector<crow::json::wvalue> getAllBookings() {
-        auto bookings = bookingList.toVector();
-        std::vector<crow::json::wvalue> jsonBookings;
-        
-        for (const auto& booking : bookings) {
-            jsonBookings.push_back(booking.toJSON());
-        }
-        
-        return jsonBookings;
+    bool writeAllBookings(JsonWriter& json, const PageQuery& page) {
+        ReadLock lock(bookingMutex);
+        return writePage(json, "bookings", bookingLog, page, 224, [&](int start, auto fn) {
+            if (page.newestFirst) {
+                bookingLog.forEachBackFrom(start, fn);
+            } else {
+                bookingLog.forEachFrom(start, fn);
+            }
+        });
     }
     
     bool checkIn(int bookingId) {
-        auto bookings = bookingList.toVector();
-        for (auto& booking : bookings) {
-            if (booking.bookingId == bookingId && booking.status == "Confirmed") {
-                booking.status = "CheckedIn";
-                roomTree.updateRoomStatus(booking.roomNumber, "Occupied");
-                return true;
-            }
+        WriteLock bookingLock(bookingMutex);
+        WriteLock roomLock(roomMutex);
+        Booking* booking = bookingLog.find(bookingId);
+        if (booking != nullptr && booking->status == BookingStatus::Confirmed) {
+            setBookingStatus(*booking, BookingStatus::CheckedIn);
+            int from, to;
+            if (stayOf(*booking, from, to)) calendar.markCheckedIn(booking->roomNumber, from, booking->bookingId);
+            refreshRoomStatus(booking->roomNumber);
+            return true;
         }
         return false;
     }
     
     crow::json::wvalue checkOut(int bookingId) {
         crow::json::wvalue response;
-        auto bookings = bookingList.toVector();
-        
-        for (auto& booking : bookings) {
-            if (booking.bookingId == bookingId && booking.status == "CheckedIn") {
-                booking.status = "CheckedOut";
-                roomTree.updateRoomStatus(booking.roomNumber, "Available");
-                
-                response["success"] = true;
-                response["totalBill"] = booking.totalAmount;
-                response["message"] = "Check-out successful";
-                
-                // Process waiting queue
-                if (!waitingQueue.empty()) {
-                    Booking waitingBooking = waitingQueue.front();
-                    waitingQueue.pop();
-                    // Notify or auto-confirm waiting booking
-                }
-                
-                return response;
-            }
+        WriteLock bookingLock(bookingMutex);
+        WriteLock roomLock(roomMutex);
+        Booking* booking = bookingLog.find(bookingId);
+        
+        if (booking != nullptr && booking->status == BookingStatus::CheckedIn) {
+            setBookingStatus(*booking, BookingStatus::CheckedOut);
+            releaseStay(*booking);
+            
+            response["success"] = true;
+            response["totalBill"] = booking->totalAmount;
+            response["message"] = "Check-out successful";
+            response["promotedBookings"] = promoteIntoStay(*booking);
+            return response;
         }
         
         response["success"] = false;
@@ -324,19 +759,45 @@ public:
     }
     
     bool cancelBooking(int bookingId) {
-        auto bookings = bookingList.toVector();
-        for (auto& booking : bookings) {
-            if (booking.bookingId == bookingId) {
-                if (booking.status == "Confirmed" || booking.status == "Pending") {
-                    booking.status = "Cancelled";
-                    roomTree.updateRoomStatus(booking.roomNumber, "Available");
-                    return true;
-                }
+        WriteLock bookingLock(bookingMutex);
+        WriteLock roomLock(roomMutex);
+        Booking* booking = bookingLog.find(bookingId);
+        if (booking != nullptr) {
+            if (booking->status == BookingStatus::Confirmed || booking->status == BookingStatus::Pending) {
+                setBookingStatus(*booking, BookingStatus::Cancelled);
+                releaseStay(*booking);
+                promoteIntoStay(*booking);
+                return true;
+            }
+            if (booking->status == BookingStatus::Waiting) {
+                waitlist.remove(bookingId);
+                setBookingStatus(*booking, BookingStatus::Cancelled);
+                return true;
             }
         }
         return false;
     }
     
+    // Waiting bookings with their place in line, optionally only one guest's. Walks
+    // the queues themselves, so the cost is O(waiting bookings), not O(all bookings).
+    std::vector<crow::json::wvalue> getWaitlist(const std::string& userId) {
+        ReadLock bookingLock(bookingMutex);
+        ReadLock roomLock(roomMutex);
+        std::vector<crow::json::wvalue> entries;
+        waitlist.forEachWaiting([&](int bookingId, int position) {
+            const Booking* booking = bookingLog.find(bookingId);
+            if (booking == nullptr || booking->status != BookingStatus::Waiting) return;
+            if (!userId.empty() && booking->userId != userId) return;
+            crow::json::wvalue json = booking->toJSON();
+            const Room* room = roomIndex.search(booking->roomNumber);
+            json["queue"] = booking->anyRoomOfType ? "type" : "room";
+            if (room != nullptr) json["roomType"] = toString(room->type);
+            json["position"] = position;
+            entries.push_back(std::move(json));
+        });
+        return entries;
+    }
+    
     // ==================== FOOD ORDER MANAGEMENT ====================
     
     crow::json::wvalue createFoodOrder(const std::string& userId, int roomNumber, 
@@ -344,16 +805,28 @@ public:
                                         double totalPrice) {
         crow::json::wvalue response;
         
+        bool controlCharacters = hasControlCharacters(userId);
+        for (const auto& item : items) {
+            controlCharacters = controlCharacters || hasControlCharacters(item.first);
+        }
+        if (controlCharacters) {
+            response["success"] = false;
+            response["message"] = "Order fields can't contain control characters";
+            return response;
+        }
+        
         FoodOrder order;
-        order.orderId = generateID();
+        order.orderId = orderIds.allocate();
         order.userId = userId;
         order.roomNumber = roomNumber;
         order.items = items;
         order.totalPrice = totalPrice;
-        order.status = "Pending";
+        order.status = OrderStatus::Pending;
         order.orderTime = getCurrentDateTime();
         
-        foodOrderList.append(order);
+        WriteLock lock(orderMutex);
+        foodOrderLog.append(order);
+        journal.append("ORDER", order.toFileString());
         
         response["success"] = true;
         response["orderId"] = order.orderId;
@@ -363,27 +836,25 @@ public:
     }
     
     std::vector<crow::json::wvalue> getUserOrders(const std::string& userId) {
-        auto orders = foodOrderList.toVector();
+        ReadLock lock(orderMutex);
         std::vector<crow::json::wvalue> userOrders;
         
-        for (const auto& order : orders) {
-            if (order.userId == userId) {
-                userOrders.push_back(order.toJSON());
-            }
-        }
+        foodOrderLog.forEachByUser(userId, [&](const FoodOrder& order) {
+            userOrders.push_back(order.toJSON());
+        });
         
         return userOrders;
     }
     
-    std::vector<crow::json::wvalue> getAllOrders() {
-        auto orders = foodOrderList.toVector();
-        std::vector<crow::json::wvalue> jsonOrders;
-        
-        for (const auto& order : orders) {
-            jsonOrders.push_back(order.toJSON());
-        }
-        
-        return jsonOrders;
+    bool writeAllOrders(JsonWriter& json, const PageQuery& page) {
+        ReadLock lock(orderMutex);
+        return writePage(json, "orders", foodOrderLog, page, 192, [&](int start, auto fn) {
+            if (page.newestFirst) {
+                foodOrderLog.forEachBackFrom(start, fn);
+            } else {
+                foodOrderLog.forEachFrom(start, fn);
+            }
+        });
     }
     
     // ==================== SERVICE REQUEST MANAGEMENT ====================
@@ -392,10 +863,25 @@ public:
                                              const std::string& description, int priority) {
         crow::json::wvalue response;
         
-        ServiceRequest request(generateID(), roomNumber, type, description, priority,
-                              "Pending", getCurrentDateTime(), "Unassigned");
+        ServiceType serviceType;
+        if (!parse(type, serviceType)) {
+            response["success"] = false;
+            response["message"] = "Invalid service type";
+            return response;
+        }
+        if (hasControlCharacters(description)) {
+            response["success"] = false;
+            response["message"] = "Description can't contain control characters";
+            return response;
+        }
         
+        ServiceRequest request(requestIds.allocate(), roomNumber, serviceType, description, priority,
+                              ServiceStatus::Pending, getCurrentDateTime(), "Unassigned");
+        
+        WriteLock lock(serviceMutex);
         serviceRequestQueue.push(request);
+        serviceRequestIds.insert(request.requestId);
+        journal.append("SERVICE", request.toFileString());
         
         response["success"] = true;
         response["requestId"] = request.requestId;
@@ -406,12 +892,16 @@ public:
     
     std::vector<crow::json::wvalue> getPendingServiceRequests() {
         std::vector<crow::json::wvalue> requests;
-        std::priority_queue<ServiceRequest> tempQueue = serviceRequestQueue;
+        std::priority_queue<ServiceRequest> tempQueue;
+        {
+            ReadLock lock(serviceMutex);
+            tempQueue = serviceRequestQueue;
+        }
         
         while (!tempQueue.empty()) {
             ServiceRequest req = tempQueue.top();
             tempQueue.pop();
-            if (req.status == "Pending") {
+            if (req.status == ServiceStatus::Pending) {
                 requests.push_back(req.toJSON());
             }
         }
@@ -419,12 +909,14 @@ public:
         return requests;
     }
     
-    ServiceRequest* getNextServiceRequest() {
+    // Copies the top request out; a pointer into the queue would dangle once the lock is released
+    bool getNextServiceRequest(ServiceRequest& request) {
+        ReadLock lock(serviceMutex);
         if (!serviceRequestQueue.empty()) {
-            static ServiceRequest req = serviceRequestQueue.top();
-            return &req;
+            request = serviceRequestQueue.top();
+            return true;
         }
-        return nullptr;
+        return false;
     }
     
     // ==================== BILLING ====================
@@ -434,21 +926,20 @@ public:
         double roomCharges = 0.0;
         double foodCharges = 0.0;
         
+        ReadLock bookingLock(bookingMutex);
+        ReadLock orderLock(orderMutex);
+        
         // Calculate room charges
-        auto bookings = bookingList.toVector();
-        for (const auto& booking : bookings) {
-            if (booking.userId == userId && booking.status == "CheckedIn") {
+        bookingLog.forEachByUser(userId, [&](const Booking& booking) {
+            if (booking.status == BookingStatus::CheckedIn) {
                 roomCharges += booking.totalAmount;
             }
-        }
+        });
         
         // Calculate food charges
-        auto orders = foodOrderList.toVector();
-        for (const auto& order : orders) {
-            if (order.userId == userId) {
-                foodCharges += order.totalPrice;
-            }
-        }
+        foodOrderLog.forEachByUser(userId, [&](const FoodOrder& order) {
+            foodCharges += order.totalPrice;
+        });
         
         double total = roomCharges + foodCharges;
         double tax = total * 0.18;  // 18% tax
@@ -465,130 +956,497 @@ public:
     
     // ==================== REPORTS & ANALYTICS ====================
     
+    // O(1): every figure is a maintained counter
     crow::json::wvalue getDashboardStats() {
         crow::json::wvalue stats;
         
-        auto allRooms = roomTree.getAllRooms();
-        int totalRooms = allRooms.size();
-        int occupiedRooms = 0;
-        int availableRooms = 0;
-        
-        for (const auto& room : allRooms) {
-            if (room.status == "Occupied") occupiedRooms++;
-            if (room.status == "Available") availableRooms++;
-        }
-        
-        auto bookings = bookingList.toVector();
-        int totalBookings = bookings.size();
-        int activeBookings = 0;
-        double totalRevenue = 0.0;
+        ReadLock bookingLock(bookingMutex);
+        ReadLock roomLock(roomMutex);
+        ReadLock serviceLock(serviceMutex);
+#ifdef HOTEL_CHECK_COUNTERS
+        checkDashboardCounters();
+#endif
         
-        for (const auto& booking : bookings) {
-            if (booking.status == "CheckedIn") activeBookings++;
-            if (booking.status == "CheckedOut") totalRevenue += booking.totalAmount;
-        }
+        int totalRooms = roomIndex.size();
+        int occupiedRooms = roomIndex.countByStatus(RoomStatus::Occupied);
         
         stats["totalRooms"] = totalRooms;
         stats["occupiedRooms"] = occupiedRooms;
-        stats["availableRooms"] = availableRooms;
+        stats["availableRooms"] = roomIndex.countByStatus(RoomStatus::Available);
         stats["occupancyRate"] = totalRooms > 0 ? (occupiedRooms * 100.0 / totalRooms) : 0;
-        stats["totalBookings"] = totalBookings;
-        stats["activeBookings"] = activeBookings;
-        stats["totalRevenue"] = totalRevenue;
+        stats["totalBookings"] = bookingLog.getSize();
+        stats["activeBookings"] = bookingTotals.active;
+        stats["totalRevenue"] = bookingTotals.revenue;
         stats["pendingServiceRequests"] = (int)serviceRequestQueue.size();
         
         return stats;
     }
     
+    // Callers hold bookingMutex
+    BookingTotals computeBookingTotals() {
+        BookingTotals totals;
+        bookingLog.forEach([&](const Booking& booking) {
+            totals.apply(booking, +1);
+        });
+        return totals;
+    }
+    
+    // Recomputes every counter from scratch and logs any that drifted; false if one
+    // did. O(bookings + rooms), so the stats endpoint only runs it in builds compiled
+    // with -DHOTEL_CHECK_COUNTERS. Callers hold the booking and room locks.
+    bool checkDashboardCounters() {
+        bool consistent = true;
+        BookingTotals expected = computeBookingTotals();
+        if (expected.active != bookingTotals.active ||
+            std::fabs(expected.revenue - bookingTotals.revenue) > 1e-6 * std::max(1.0, std::fabs(expected.revenue))) {
+            std::cerr << "Dashboard counters drifted: active " << bookingTotals.active << " vs " << expected.active
+                      << ", revenue " << bookingTotals.revenue << " vs " << expected.revenue << std::endl;
+            consistent = false;
+        }
+        
+        int byStatus[ROOM_STATUS_COUNT] = {};
+        roomIndex.forEach([&](const Room& room) {
+            byStatus[static_cast<int>(room.status)]++;
+        });
+        for (int status = 0; status < ROOM_STATUS_COUNT; status++) {
+            if (byStatus[status] != roomIndex.countByStatus(static_cast<RoomStatus>(status))) {
+                std::cerr << "Room status index drifted for " << ROOM_STATUS_NAMES[status] << ": "
+                          << roomIndex.countByStatus(static_cast<RoomStatus>(status)) << " indexed vs "
+                          << byStatus[status] << " rooms" << std::endl;
+                consistent = false;
+            }
+        }
+        return consistent;
+    }
+    
+    // Checks the invariants the locking has to preserve, logging each violation: the
+    // dashboard counters match a recount, every room is in exactly one status set,
+    // and no two confirmed or checked-in stays in a room overlap. Takes the read
+    // locks, so it can run while other threads mutate. Used by stress_test.cpp.
+    bool checkConsistency() {
+        ReadLock bookingLock(bookingMutex);
+        ReadLock roomLock(roomMutex);
+        bool consistent = checkDashboardCounters();
+        
+        int indexed = 0;
+        for (int status = 0; status < ROOM_STATUS_COUNT; status++) {
+            indexed += roomIndex.countByStatus(static_cast<RoomStatus>(status));
+        }
+        if (indexed != roomIndex.size()) {
+            std::cerr << "Status sets hold " << indexed << " rooms, index holds " << roomIndex.size() << std::endl;
+            consistent = false;
+        }
+        
+        std::unordered_map<int, std::vector<std::pair<int, int>>> stays;
+        bookingLog.forEach([&](const Booking& booking) {
+            int from, to;
+            if ((booking.status == BookingStatus::Confirmed || booking.status == BookingStatus::CheckedIn) &&
+                stayOf(booking, from, to)) {
+                stays[booking.roomNumber].push_back({from, to});
+            }
+        });
+        for (auto& room : stays) {
+            std::sort(room.second.begin(), room.second.end());
+            for (size_t i = 1; i < room.second.size(); i++) {
+                if (room.second[i].first < room.second[i - 1].second) {
+                    std::cerr << "Room " << room.first << " has overlapping stays" << std::endl;
+                    consistent = false;
+                    break;
+                }
+            }
+        }
+        return consistent;
+    }
+    
     // ==================== FILE I/O ====================
     
+    // The files feed independent containers, so each one loads on its own thread.
+    // Only called from the constructor, before any request can see the containers.
+    // Loads whichever format the last snapshot was written in, even if new snapshots
+    // will use the other one: the journal only replays on top of that state, and the
+    // other format's files may be stale.
     void loadAllData() {
-        loadRooms();
-        loadUsers();
-        loadBookings();
-        // Add more as needed
+        SnapshotFormat current;
+        if (!readSnapshotFormat(current)) {
+            throw std::runtime_error("both " + SNAPSHOT_FILE + " and .dat files exist and " + FORMAT_FILE +
+                                     " is missing, so it is unknown which is current; write \"text\" or "
+                                     "\"binary\" to " + FORMAT_FILE + " to choose");
+        }
+        if (current != snapshotFormat) {
+            std::cout << "Loading the " << (current == SnapshotFormat::Binary ? "binary" : "text")
+                      << " snapshot; the next snapshot switches format" << std::endl;
+        }
+        if (current == SnapshotFormat::Binary) {
+            if (!loadBinarySnapshot()) {
+                throw std::runtime_error(SNAPSHOT_FILE + " is the current snapshot but can't be read");
+            }
+            return;
+        }
+        
+        std::vector<std::future<void>> loaders;
+        loaders.push_back(std::async(std::launch::async, [this]() { loadRooms(); }));
+        loaders.push_back(std::async(std::launch::async, [this]() { loadUsers(); }));
+        loaders.push_back(std::async(std::launch::async, [this]() { loadBookings(); }));
+        loaders.push_back(std::async(std::launch::async, [this]() { loadOrders(); }));
+        loadServiceRequests();
+        for (auto& loader : loaders) {
+            loader.get();
+        }
+    }
+    
+    // From FORMAT_FILE; without it (state saved before the file existed) from whichever
+    // format is present. False if both are and nothing says which is newer.
+    bool readSnapshotFormat(SnapshotFormat& format) const {
+        std::ifstream marker(FORMAT_FILE);
+        std::string name;
+        if (marker >> name) {
+            if (name == "binary") format = SnapshotFormat::Binary;
+            else if (name == "text") format = SnapshotFormat::Text;
+            else return false;
+            return true;
+        }
+        
+        bool hasBinary = std::filesystem::exists(SNAPSHOT_FILE);
+        bool hasText = false;
+        for (const std::string* path : {&ROOMS_FILE, &USERS_FILE, &BOOKINGS_FILE, &ORDERS_FILE, &REQUESTS_FILE}) {
+            hasText = hasText || std::filesystem::exists(*path);
+        }
+        if (hasBinary && hasText) return false;
+        format = hasBinary ? SnapshotFormat::Binary : SnapshotFormat::Text;
+        return true;
     }
     
-    void saveAllData() {
-        saveRooms();
-        saveUsers();
-        saveBookings();
-        // Add more as needed
+    // Moves each id allocator past every id in the loaded and replayed records
+    void recoverIds() {
+        bookingLog.forEach([&](const Booking& booking) { bookingIds.observe(booking.bookingId); });
+        foodOrderLog.forEach([&](const FoodOrder& order) { orderIds.observe(order.orderId); });
+        for (int requestId : serviceRequestIds) requestIds.observe(requestId);
     }
     
-    void loadRooms() {
-        std::ifstream file(ROOMS_FILE);
-        if (!file.is_open()) return;
+    // Builds the reservation calendar and waitlists from the bookings once they are loaded and
+    // the journal replayed, then makes room statuses agree with it (e.g. after a crash
+    // between two writes). Maintenance is a manual state and is left alone.
+    void rebuildCalendar() {
+        calendar.clear();
+        waitlist.clear();
+        roomIndex.forEach([&](const Room& room) { calendar.addRoom(room.roomNumber); });
+        bookingLog.forEach([&](const Booking& booking) {
+            if (booking.status == BookingStatus::Waiting) {
+                enqueueWaiting(booking);  // Log order is arrival order
+                return;
+            }
+            if (booking.status != BookingStatus::Confirmed && booking.status != BookingStatus::CheckedIn) return;
+            int from, to;
+            if (!stayOf(booking, from, to) || !calendar.reserve(booking.roomNumber, from, to, booking.bookingId)) {
+                std::cerr << "Booking " << booking.bookingId << " has invalid or overlapping dates; "
+                          << "not holding room " << booking.roomNumber << std::endl;
+                return;
+            }
+            if (booking.status == BookingStatus::CheckedIn) {
+                calendar.markCheckedIn(booking.roomNumber, from, booking.bookingId);
+            }
+        });
         
-        std::string line;
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                Room room = Room::fromFileString(line);
-                roomTree.insert(room);
+        for (const auto& room : roomIndex.getAllRooms()) {
+            if (room.status == RoomStatus::Maintenance) continue;
+            RoomStatus status = calendar.derivedStatus(room.roomNumber);
+            if (room.status != status) {
+                roomIndex.updateRoomStatus(room.roomNumber, status);
             }
         }
-        file.close();
     }
     
-    void saveRooms() {
-        std::ofstream file(ROOMS_FILE);
-        if (!file.is_open()) return;
+    // Run from the journal's flusher thread. Handlers only wait while state is copied
+    // under the shared locks (readers not at all); the journal is rotated in the same
+    // window, so the copy and the rotated records line up exactly. Serializing and the
+    // temp file + fsync + rename happen on a background thread, and the rotated
+    // records are dropped only once the snapshot is durable.
+    void takeSnapshot() {
+        if (pendingSnapshot.valid() &&
+            pendingSnapshot.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;  // Previous snapshot still writing; the policy fires again later
+        }
         
-        auto rooms = roomTree.getAllRooms();
-        for (const auto& room : rooms) {
-            file << room.toFileString() << "\n";
+        SnapshotData data;
+        {
+            ReadLock userLock(userMutex);
+            ReadLock bookingLock(bookingMutex);
+            ReadLock orderLock(orderMutex);
+            ReadLock roomLock(roomMutex);
+            ReadLock serviceLock(serviceMutex);
+            
+            data = collectSnapshot();
+            if (!journal.rotate()) return;
         }
-        file.close();
+        
+        pendingSnapshot = std::async(std::launch::async, [this, data = std::move(data)]() {
+            if (writeSnapshot(data, snapshotFormat)) {
+                journal.dropRotated();
+            } else {
+                std::cerr << "Snapshot write failed; keeping rotated journal for replay" << std::endl;
+            }
+        });
     }
     
-    void loadUsers() {
-        std::ifstream file(USERS_FILE);
-        if (!file.is_open()) return;
+    // Writes the current state in `format` without touching the journal (whose records
+    // are idempotent on top of it); used to convert between the two formats
+    bool convertSnapshot(SnapshotFormat format) {
+        SnapshotData data;
+        {
+            ReadLock userLock(userMutex);
+            ReadLock bookingLock(bookingMutex);
+            ReadLock orderLock(orderMutex);
+            ReadLock roomLock(roomMutex);
+            ReadLock serviceLock(serviceMutex);
+            
+            data = collectSnapshot();
+        }
+        return writeSnapshot(data, format);
+    }
+    
+    // Callers hold every aggregate lock
+    SnapshotData collectSnapshot() {
+        SnapshotData data;
+        data.rooms = roomIndex.getAllRooms();
+        data.users = userTable.getAllValues();
+        data.bookings.reserve(bookingLog.getSize());
+        bookingLog.forEach([&](const Booking& booking) { data.bookings.push_back(booking); });
+        data.orders.reserve(foodOrderLog.getSize());
+        foodOrderLog.forEach([&](const FoodOrder& order) { data.orders.push_back(order); });
         
-        std::string line;
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                User user = User::fromFileString(line);
-                userTable.insert(user.userId, user);
-            }
+        // Copy so the live queue is left intact; kept highest priority first
+        std::priority_queue<ServiceRequest> tempQueue = serviceRequestQueue;
+        while (!tempQueue.empty()) {
+            data.requests.push_back(tempQueue.top());
+            tempQueue.pop();
         }
-        file.close();
+        return data;
     }
     
-    void saveUsers() {
-        std::ofstream file(USERS_FILE);
-        if (!file.is_open()) return;
+    // Each file is replaced atomically. A crash between two text files leaves some old
+    // and some new, which the rotated journal (still on disk) replays back into sync.
+    // FORMAT_FILE is switched only once the whole snapshot is durable, so until then
+    // a restart still loads the previous one.
+    bool writeSnapshot(const SnapshotData& data, SnapshotFormat format) {
+        bool ok;
+        if (format == SnapshotFormat::Binary) {
+            ok = writeFileAtomically(SNAPSHOT_FILE, SnapshotWriter().serialize(data));
+        } else {
+            ok = writeFileAtomically(ROOMS_FILE, toFileLines(data.rooms));
+            ok = writeFileAtomically(USERS_FILE, toFileLines(data.users)) && ok;
+            ok = writeFileAtomically(BOOKINGS_FILE, toFileLines(data.bookings)) && ok;
+            ok = writeFileAtomically(ORDERS_FILE, toFileLines(data.orders)) && ok;
+            ok = writeFileAtomically(REQUESTS_FILE, toFileLines(data.requests)) && ok;
+        }
+        return ok && writeFileAtomically(FORMAT_FILE, format == SnapshotFormat::Binary ? "binary\n" : "text\n");
+    }
+    
+    template<typename Record>
+    static std::string toFileLines(const std::vector<Record>& records) {
+        std::string text;
+        for (const auto& record : records) {
+            text += record.toFileString();
+            text += '\n';
+        }
+        return text;
+    }
+    
+    // Records are upserts/absolute states, so replaying one that the snapshot
+    // already contains is harmless
+    void replayJournal() {
+        Journal::replay(JOURNAL_FILE, [this](const std::string& op, const std::string& payload) {
+            try {
+                applyJournalRecord(op, payload);
+            } catch (...) {
+                std::cerr << "Skipping bad journal record: " << op << std::endl;
+            }
+        });
+    }
+    
+    void applyJournalRecord(const std::string& op, const std::string& payload) {
+        size_t separator = payload.find('|');
         
-        auto users = userTable.getAllValues();
-        for (const auto& user : users) {
-            file << user.toFileString() << "\n";
+        if (op == "ROOM") {
+            Room room = Room::fromFileString(payload);
+            if (!roomIndex.update(room.roomNumber, room)) {
+                roomIndex.insert(room);
+            }
+        } else if (op == "ROOM_DELETE") {
+            roomIndex.deleteRoom(std::stoi(payload));
+        } else if (op == "ROOM_STATUS") {
+            RoomStatus status;
+            if (parse(payload.substr(separator + 1), status)) {
+                roomIndex.updateRoomStatus(std::stoi(payload.substr(0, separator)), status);
+            }
+        } else if (op == "USER") {
+            User user = User::fromFileString(payload);
+            userTable.insert(user.userId, user);
+        } else if (op == "USER_DELETE") {
+            userTable.remove(payload);
+        } else if (op == "BOOKING") {
+            Booking booking = Booking::fromFileString(payload);
+            Booking* existing = bookingLog.find(booking.bookingId);
+            if (existing != nullptr) {
+                *existing = booking;
+            } else {
+                bookingLog.append(booking);
+            }
+        } else if (op == "BOOKING_STATUS") {
+            Booking* booking = bookingLog.find(std::stoi(payload.substr(0, separator)));
+            if (booking != nullptr) {
+                parse(payload.substr(separator + 1), booking->status);
+            }
+        } else if (op == "ORDER") {
+            FoodOrder order = FoodOrder::fromFileString(payload);
+            FoodOrder* existing = foodOrderLog.find(order.orderId);
+            if (existing != nullptr) {
+                *existing = order;
+            } else {
+                foodOrderLog.append(order);
+            }
+        } else if (op == "SERVICE") {
+            ServiceRequest request = ServiceRequest::fromFileString(payload);
+            if (serviceRequestIds.insert(request.requestId).second) {
+                serviceRequestQueue.push(request);
+            }
         }
-        file.close();
     }
     
-    void loadBookings() {
-        std::ifstream file(BOOKINGS_FILE);
-        if (!file.is_open()) return;
+    // Maps the whole file and parses it in parallel chunks split on line boundaries,
+    // then hands the records to `add` in file order and reports load throughput
+    template<typename Record, typename Reserve, typename Add>
+    void loadFile(const std::string& path, const char* label, Reserve reserve, Add add) {
+        MappedFile file;
+        if (!file.open(path)) return;
         
-        std::string line;
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                Booking booking = Booking::fromFileString(line);
-                bookingList.append(booking);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::string_view> chunks = splitOnLines(file.view());
+        std::vector<std::vector<Record>> parsed(chunks.size());
+        
+        auto parseChunk = [&](size_t index) {
+            MappedFile::forEachLine(chunks[index], [&](std::string_view line) {
+                parsed[index].push_back(Record::fromFileString(line));
+            });
+        };
+        std::vector<std::future<void>> workers;
+        for (size_t i = 1; i < chunks.size(); i++) {
+            workers.push_back(std::async(std::launch::async, parseChunk, i));
+        }
+        if (!chunks.empty()) parseChunk(0);
+        for (auto& worker : workers) {
+            worker.get();
+        }
+        
+        size_t records = 0;
+        for (const auto& chunk : parsed) records += chunk.size();
+        reserve(records);
+        for (auto& chunk : parsed) {
+            for (auto& record : chunk) {
+                add(record);
             }
         }
-        file.close();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        // One write so lines from concurrent loaders don't interleave
+        double megabytes = file.size() / (1024.0 * 1024.0);
+        std::ostringstream report;
+        report << "Loaded " << records << " " << label << " from " << path << " ("
+               << std::fixed << std::setprecision(1) << megabytes << " MB in "
+               << std::setprecision(3) << seconds << " s, "
+               << std::setprecision(1) << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s, "
+               << chunks.size() << " chunk(s))\n";
+        std::cout << report.str() << std::flush;
+    }
+    
+    // Small files stay in one chunk; big ones get one chunk per hardware thread
+    static std::vector<std::string_view> splitOnLines(std::string_view text) {
+        const size_t MIN_CHUNK_BYTES = 4 * 1024 * 1024;
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t count = std::max<size_t>(1, std::min(threads, text.size() / MIN_CHUNK_BYTES));
+        
+        std::vector<std::string_view> chunks;
+        size_t begin = 0;
+        for (size_t i = 1; i <= count && begin < text.size(); i++) {
+            size_t end = (i == count) ? text.size() : text.find('\n', text.size() * i / count);
+            end = (end == std::string_view::npos) ? text.size() : std::min(text.size(), end + 1);
+            if (end <= begin) continue;
+            chunks.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+        return chunks;
+    }
+    
+    void loadRooms() {
+        loadFile<Room>(ROOMS_FILE, "rooms", [this](size_t count) { roomIndex.reserve(count); },
+                       [this](Room& room) { roomIndex.insert(std::move(room)); });
+    }
+    
+    void loadUsers() {
+        loadFile<User>(USERS_FILE, "users", [this](size_t count) { userTable.reserve(count); },
+                       [this](User& user) { userTable.insert(user.userId, user); });
+    }
+    
+    void loadBookings() {
+        loadFile<Booking>(BOOKINGS_FILE, "bookings", [](size_t) {},
+                          [this](Booking& booking) { bookingLog.append(booking); });
+    }
+    
+    void loadOrders() {
+        loadFile<FoodOrder>(ORDERS_FILE, "orders", [](size_t) {},
+                            [this](FoodOrder& order) { foodOrderLog.append(order); });
     }
     
-    void saveBookings() {
-        std::ofstream file(BOOKINGS_FILE);
-        if (!file.is_open()) return;
+    void loadServiceRequests() {
+        loadFile<ServiceRequest>(REQUESTS_FILE, "service requests", [](size_t) {},
+                                 [this](ServiceRequest& request) {
+            if (serviceRequestIds.insert(request.requestId).second) {
+                serviceRequestQueue.push(request);
+            }
+        });
+    }
+    
+    bool loadBinarySnapshot() {
+        MappedFile file;
+        if (!file.open(SNAPSHOT_FILE)) return false;
+        
+        auto start = std::chrono::steady_clock::now();
+        SnapshotData data;
+        std::string error;
+        if (!SnapshotReader().read(file.view(), data, error)) {
+            std::cerr << "Ignoring " << SNAPSHOT_FILE << ": " << error << std::endl;
+            return false;
+        }
         
-        auto bookings = bookingList.toVector();
-        for (const auto& booking : bookings) {
-            file << booking.toFileString() << "\n";
+        roomIndex.reserve(data.rooms.size());
+        for (auto& room : data.rooms) {
+            roomIndex.insert(std::move(room));
+        }
+        userTable.reserve(data.users.size());
+        for (const auto& user : data.users) {
+            userTable.insert(user.userId, user);
+        }
+        for (const auto& booking : data.bookings) {
+            bookingLog.append(booking);
+        }
+        for (const auto& order : data.orders) {
+            foodOrderLog.append(order);
         }
-        file.close();
+        for (const auto& request : data.requests) {
+            if (serviceRequestIds.insert(request.requestId).second) {
+                serviceRequestQueue.push(request);
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        double megabytes = file.size() / (1024.0 * 1024.0);
+        std::cout << "Loaded snapshot " << SNAPSHOT_FILE << ": " << data.rooms.size() << " rooms, "
+                  << data.users.size() << " users, " << data.bookings.size() << " bookings, "
+                  << data.orders.size() << " orders, " << data.requests.size() << " service requests ("
+                  << std::fixed << std::setprecision(1) << megabytes << " MB in "
+                  << std::setprecision(3) << seconds << " s, "
+                  << std::setprecision(1) << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s)"
+                  << std::endl;
+        return true;
     }
 };
 
@@ -0,0 +1,141 @@
+#ifndef IDEMPOTENCY_CACHE_H
+#define IDEMPOTENCY_CACHE_H
+
+#include "crow_all.h"
+#include "hotel_system.h"
+#include <string>
+#include <list>
+#include <iterator>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+// ==================== IDEMPOTENCY KEYS ====================
+
+// Remembers the response to each create request that carried an Idempotency-Key
+// header, so a client retry or a double-click gets the original response back
+// instead of creating a second record.
+//
+// Entries live in insertion order in a list indexed by a hash map. Every entry has
+// the same time to live, so expired entries are always at the front, and dropping
+// them (or the oldest entries once the table is full) is O(1) each. A retry that
+// arrives while the first request is still running waits for its response. Reusing
+// a key with a different body is rejected with 409. Keys are scoped per route.
+class IdempotencyCache {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string key;
+        uint64_t fingerprint;     // hashString() of the request body
+        Clock::time_point expires;
+        bool done;
+        int code;
+        std::string body;
+        std::string contentType;
+    };
+
+    size_t capacity;
+    std::chrono::seconds ttl;
+    std::chrono::seconds waitLimit;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::list<Entry> entries;  // Oldest first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+    void erase(std::list<Entry>::iterator it) {
+        index.erase(it->key);
+        entries.erase(it);
+    }
+
+    // Callers hold the mutex. Requests still running are never evicted, so the
+    // table can briefly exceed its capacity while they finish.
+    void evict(Clock::time_point now) {
+        while (!entries.empty() && entries.front().done &&
+               (entries.front().expires <= now || entries.size() >= capacity)) {
+            erase(entries.begin());
+        }
+    }
+
+    static crow::response replay(const Entry& entry) {
+        crow::response res(entry.code, entry.body);
+        if (!entry.contentType.empty()) res.set_header("Content-Type", entry.contentType);
+        res.set_header("Idempotent-Replayed", "true");
+        return res;
+    }
+
+public:
+    IdempotencyCache(size_t maxEntries, std::chrono::seconds timeToLive)
+        : capacity(maxEntries), ttl(timeToLive), waitLimit(30) {}
+
+    IdempotencyCache(const IdempotencyCache&) = delete;
+    IdempotencyCache& operator=(const IdempotencyCache&) = delete;
+
+    // Runs handler() once per (scope, Idempotency-Key) and returns its response, or
+    // the stored one for a repeat. Requests without the header always run.
+    template<typename Handler>
+    crow::response run(const crow::request& req, const std::string& scope, Handler handler) {
+        const std::string& header = req.get_header_value("Idempotency-Key");
+        if (header.empty()) return handler();
+        if (header.size() > 255) return crow::response(400, "Idempotency-Key is too long");
+
+        std::string key = scope + "|" + header;
+        uint64_t fingerprint = hashString(req.body);
+        std::list<Entry>::iterator it;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            Clock::time_point now = Clock::now();
+            evict(now);
+
+            auto found = index.find(key);
+            if (found != index.end()) {
+                it = found->second;
+                if (it->fingerprint != fingerprint) {
+                    return crow::response(409, "Idempotency-Key was already used with a different request");
+                }
+                if (!it->done) {
+                    bool ready = finished.wait_for(lock, waitLimit, [&] {
+                        auto current = index.find(key);
+                        return current == index.end() || current->second->done;
+                    });
+                    if (!ready) return crow::response(409, "A request with this Idempotency-Key is still in progress");
+                    found = index.find(key);
+                    if (found == index.end()) {
+                        return crow::response(409, "The original request with this Idempotency-Key failed; retry");
+                    }
+                }
+                return replay(*found->second);
+            }
+
+            entries.push_back(Entry{key, fingerprint, now + ttl, false, 0, std::string(), std::string()});
+            it = std::prev(entries.end());
+            index.emplace(key, it);
+        }
+
+        crow::response res;
+        try {
+            res = handler();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            erase(it);
+            finished.notify_all();
+            throw;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (res.code >= 500) {
+            erase(it);  // Not a decided outcome; let the retry run again
+        } else {
+            it->done = true;
+            it->code = res.code;
+            it->body = res.body;
+            it->contentType = res.get_header_value("Content-Type");
+        }
+        finished.notify_all();
+        return res;
+    }
+};
+
+#endif // IDEMPOTENCY_CACHE_H
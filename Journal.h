@@ -0,0 +1,297 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <filesystem>
+#include <iostream>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// ==================== WRITE-AHEAD JOURNAL ====================
+
+// When the journal should be folded into a new snapshot; the first limit reached wins
+struct CompactionPolicy {
+    long maxBytes = 8 * 1024 * 1024;
+    long maxRecords = 10000;
+    std::chrono::seconds interval{300};
+};
+
+// Append-only log of HotelManager mutations, one "<op>|<payload>" line per record.
+// Payloads are written with '\\', '\n' and '\r' backslash-escaped, so whatever a
+// payload holds, the only raw newline in the file is the one ending each record.
+//
+// append() hands every record to the OS before returning, so killing the process
+// loses nothing. A background thread fsyncs whatever was appended since its last
+// pass (group commit), which bounds what a power loss can lose to one sync interval
+// without paying an fsync per request. Once the compaction policy trips, the
+// owner's compaction callback is run from that same thread.
+//
+// Compaction is two-phase so the snapshot can be written in the background:
+// rotate() moves the current records aside to "<path>.old" and starts a fresh
+// file, and dropRotated() deletes them once a snapshot covering them is durable.
+// Until then replay() reads the rotated records before the current ones.
+class Journal {
+private:
+    std::string path;
+    FILE* file;
+    long bytesWritten;
+    long recordsWritten;
+    CompactionPolicy policy;
+    std::chrono::steady_clock::time_point lastRotation;
+    std::chrono::milliseconds syncInterval;
+    std::function<void()> onCompact;
+
+    std::mutex appendMutex;   // Guards file writes
+    std::mutex syncMutex;     // Guards fsync against reopen/close
+    std::atomic<bool> dirty;
+    std::atomic<bool> running;
+    std::condition_variable_any wakeUp;
+    std::thread flusher;
+
+    static void syncFile(FILE* f) {
+#ifdef _WIN32
+        _commit(_fileno(f));
+#else
+        fsync(fileno(f));
+#endif
+    }
+
+    static bool appendFile(const std::string& from, const std::string& to) {
+        FILE* in = std::fopen(from.c_str(), "rb");
+        FILE* out = std::fopen(to.c_str(), "ab");
+        bool ok = in != nullptr && out != nullptr;
+        if (ok) {
+            char buffer[64 * 1024];
+            size_t n;
+            while (ok && (n = std::fread(buffer, 1, sizeof(buffer), in)) > 0) {
+                ok = std::fwrite(buffer, 1, n, out) == n;
+            }
+            ok = ok && std::fflush(out) == 0;
+            if (ok) syncFile(out);
+        }
+        if (in != nullptr) std::fclose(in);
+        if (out != nullptr) std::fclose(out);
+        return ok;
+    }
+    
+    // Cuts a record torn by a crash mid-append off the end of the file, so the next
+    // append starts on a fresh line instead of being glued onto it
+    static bool truncateTornTail(const std::string& filePath) {
+        FILE* in = std::fopen(filePath.c_str(), "rb");
+        if (in == nullptr) return true;
+        std::fseek(in, 0, SEEK_END);
+        long size = std::ftell(in);
+        long keep = size;
+        char buffer[4096];
+        while (keep > 0) {
+            long chunk = keep < (long)sizeof(buffer) ? keep : (long)sizeof(buffer);
+            std::fseek(in, keep - chunk, SEEK_SET);
+            if (std::fread(buffer, 1, chunk, in) != (size_t)chunk) break;
+            long i = chunk;
+            while (i > 0 && buffer[i - 1] != '\n') i--;
+            keep -= chunk - i;
+            if (i > 0) break;
+        }
+        std::fclose(in);
+        if (keep == size) return true;
+        
+        std::cerr << "Journal " << filePath << ": discarding " << (size - keep)
+                  << " bytes of a record torn by a crash" << std::endl;
+        std::error_code error;
+        std::filesystem::resize_file(filePath, keep, error);
+        return !error;
+    }
+    
+    static std::string escapePayload(const std::string& payload) {
+        std::string escaped;
+        escaped.reserve(payload.size());
+        for (char c : payload) {
+            switch (c) {
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+    
+    static std::string unescapePayload(std::string_view escaped) {
+        std::string payload;
+        payload.reserve(escaped.size());
+        for (size_t i = 0; i < escaped.size(); i++) {
+            if (escaped[i] != '\\' || i + 1 == escaped.size()) {
+                payload += escaped[i];
+                continue;
+            }
+            char next = escaped[++i];
+            payload += next == 'n' ? '\n' : next == 'r' ? '\r' : next;
+        }
+        return payload;
+    }
+    
+    void flushLoop() {
+        std::unique_lock<std::mutex> lock(syncMutex);
+        while (running) {
+            wakeUp.wait_for(lock, syncInterval);
+            if (dirty.exchange(false) && file != nullptr) {
+                syncFile(file);
+            }
+
+            bool compact = false;
+            {
+                std::lock_guard<std::mutex> appendLock(appendMutex);
+                compact = running && onCompact && recordsWritten > 0 &&
+                          (bytesWritten > policy.maxBytes || recordsWritten >= policy.maxRecords ||
+                           std::chrono::steady_clock::now() - lastRotation >= policy.interval);
+            }
+            if (compact) {
+                lock.unlock();
+                onCompact();
+                lock.lock();
+            }
+        }
+    }
+
+public:
+    Journal() : file(nullptr), bytesWritten(0), recordsWritten(0),
+                lastRotation(std::chrono::steady_clock::now()),
+                syncInterval(20), dirty(false), running(false) {}
+
+    ~Journal() {
+        close();
+    }
+
+    static std::string rotatedPath(const std::string& journalPath) {
+        return journalPath + ".old";
+    }
+    
+    // Replays complete records in file order, rotated records first. A torn last
+    // line (crash mid-append) is skipped.
+    static void replay(const std::string& journalPath,
+                       const std::function<void(const std::string& op, const std::string& payload)>& apply) {
+        replayFile(rotatedPath(journalPath), apply);
+        replayFile(journalPath, apply);
+    }
+    
+    static void replayFile(const std::string& filePath,
+                           const std::function<void(const std::string& op, const std::string& payload)>& apply) {
+        FILE* in = std::fopen(filePath.c_str(), "rb");
+        if (in == nullptr) return;
+
+        std::string line;
+        int c;
+        while ((c = std::fgetc(in)) != EOF) {
+            if (c != '\n') {
+                line += static_cast<char>(c);
+                continue;
+            }
+            size_t separator = line.find('|');
+            if (separator != std::string::npos) {
+                apply(line.substr(0, separator),
+                      unescapePayload(std::string_view(line).substr(separator + 1)));
+            }
+            line.clear();
+        }
+        std::fclose(in);
+    }
+
+    // Call after replay(), which already skipped any torn last record
+    bool open(const std::string& journalPath, const CompactionPolicy& compaction,
+              std::chrono::milliseconds interval, std::function<void()> compactCallback) {
+        path = journalPath;
+        policy = compaction;
+        syncInterval = interval;
+        onCompact = std::move(compactCallback);
+
+        if (!truncateTornTail(rotatedPath(path)) || !truncateTornTail(path)) return false;
+        file = std::fopen(path.c_str(), "ab");
+        if (file == nullptr) return false;
+        std::fseek(file, 0, SEEK_END);
+        bytesWritten = std::ftell(file);
+
+        running = true;
+        flusher = std::thread(&Journal::flushLoop, this);
+        return true;
+    }
+
+    void append(const std::string& op, const std::string& payload) {
+        std::lock_guard<std::mutex> lock(appendMutex);
+        if (file == nullptr) {
+            std::cerr << "Journal " << path << " is not open; change not persisted: " << op << std::endl;
+            return;
+        }
+        std::string record = op + "|" + escapePayload(payload) + "\n";
+        std::fwrite(record.data(), 1, record.size(), file);
+        std::fflush(file);
+        bytesWritten += (long)record.size();
+        recordsWritten++;
+        dirty = true;
+    }
+
+    // Moves every record so far to the rotated file and starts an empty journal. If
+    // an earlier rotation was never dropped (its snapshot failed) the records are
+    // appended to it, so nothing is lost. The caller must block new appends while
+    // this runs and must have copied the state these records lead to.
+    bool rotate() {
+        std::lock_guard<std::mutex> syncLock(syncMutex);
+        std::lock_guard<std::mutex> lock(appendMutex);
+        if (file == nullptr) return false;
+        if (dirty.exchange(false)) syncFile(file);
+        std::fclose(file);
+        file = nullptr;
+        
+        std::string oldPath = rotatedPath(path);
+        bool moved;
+        FILE* existing = std::fopen(oldPath.c_str(), "rb");
+        if (existing == nullptr) {
+            moved = std::rename(path.c_str(), oldPath.c_str()) == 0;
+        } else {
+            std::fclose(existing);
+            moved = appendFile(path, oldPath);
+        }
+        
+        // On failure keep appending to the current file rather than losing records
+        file = std::fopen(path.c_str(), moved ? "wb" : "ab");
+        if (file != nullptr && moved) {
+            syncFile(file);
+            bytesWritten = 0;
+            recordsWritten = 0;
+        }
+        lastRotation = std::chrono::steady_clock::now();
+        dirty = false;
+        return moved;
+    }
+    
+    // Called once a snapshot that includes every rotated record is durable
+    void dropRotated() {
+        std::remove(rotatedPath(path).c_str());
+    }
+
+    void close() {
+        if (running.exchange(false)) {
+            wakeUp.notify_all();
+            flusher.join();
+        }
+        std::lock_guard<std::mutex> syncLock(syncMutex);
+        std::lock_guard<std::mutex> lock(appendMutex);
+        if (file != nullptr) {
+            syncFile(file);
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+};
+
+#endif // JOURNAL_H
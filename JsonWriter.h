@@ -0,0 +1,129 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cmath>
+#include <vector>
+
+// ==================== STREAMING JSON WRITER ====================
+
+// Appends JSON text straight into a caller-owned buffer, for list endpoints that
+// would otherwise build a crow::json::wvalue tree per record and then dump it.
+// Commas are tracked with a single flag: every value (or closed container) sets it,
+// and every key or opened container clears it, so nesting needs no stack.
+//
+// selectFields() implements ?fields= projections: field() then skips keys that
+// weren't asked for. key()/value() are never filtered, so envelopes and nested
+// objects are written with those.
+class JsonWriter {
+private:
+    std::string& out;
+    bool needsComma;
+    std::vector<std::string> selected;  // Empty = every field
+
+    void separate() {
+        if (needsComma) out += ',';
+    }
+
+    void writeString(std::string_view text) {
+        static const char* HEX = "0123456789abcdef";
+        out += '"';
+        size_t plainStart = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            out.append(text.data() + plainStart, i - plainStart);
+            plainStart = i + 1;
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                default:
+                    out += "\\u00";
+                    out += HEX[c >> 4];
+                    out += HEX[c & 0xF];
+            }
+        }
+        out.append(text.data() + plainStart, text.size() - plainStart);
+        out += '"';
+    }
+
+public:
+    explicit JsonWriter(std::string& buffer) : out(buffer), needsComma(false) {}
+
+    void reserve(size_t bytes) { out.reserve(out.size() + bytes); }
+    
+    // Comma-separated field names; blanks are ignored
+    void selectFields(std::string_view names) {
+        selected.clear();
+        while (!names.empty()) {
+            size_t comma = names.find(',');
+            std::string_view name = names.substr(0, comma);
+            while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+            while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+            if (!name.empty()) selected.emplace_back(name);
+            names = (comma == std::string_view::npos) ? std::string_view() : names.substr(comma + 1);
+        }
+    }
+    
+    bool wants(std::string_view name) const {
+        if (selected.empty()) return true;
+        for (const auto& field : selected) {
+            if (field == name) return true;
+        }
+        return false;
+    }
+
+    void beginObject() { separate(); out += '{'; needsComma = false; }
+    void endObject() { out += '}'; needsComma = true; }
+    void beginArray() { separate(); out += '['; needsComma = false; }
+    void endArray() { out += ']'; needsComma = true; }
+
+    void key(std::string_view name) {
+        separate();
+        writeString(name);
+        out += ':';
+        needsComma = false;
+    }
+
+    void value(std::string_view text) { separate(); writeString(text); needsComma = true; }
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(const std::string& text) { value(std::string_view(text)); }
+    void value(bool flag) { separate(); out += flag ? "true" : "false"; needsComma = true; }
+
+    void value(int number) {
+        separate();
+        char buffer[16];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        out.append(buffer, result.ptr);
+        needsComma = true;
+    }
+
+    // Shortest representation that round-trips; NaN/infinity aren't JSON, so null
+    void value(double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            out += "null";
+        } else {
+            char buffer[32];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            out.append(buffer, result.ptr);
+        }
+        needsComma = true;
+    }
+
+    template<typename T>
+    void field(std::string_view name, const T& fieldValue) {
+        if (!wants(name)) return;
+        key(name);
+        value(fieldValue);
+    }
+};
+
+#endif // JSON_WRITER_H
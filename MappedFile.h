@@ -0,0 +1,121 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ==================== READ-ONLY MEMORY-MAPPED FILE ====================
+
+// Maps a whole data file so loaders can scan it in one pass straight out of the
+// page cache, without per-line stream reads or copies. Lines are split with
+// memchr, which the C library implements with SIMD, so finding newlines is
+// effectively a vectorized scan.
+class MappedFile {
+private:
+    const char* begin;
+    size_t length;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int fd;
+#endif
+
+public:
+#ifdef _WIN32
+    MappedFile() : begin(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+#else
+    MappedFile() : begin(nullptr), length(0), fd(-1) {}
+#endif
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    // An existing empty file opens successfully with size() == 0
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(fileHandle, &fileSize);
+        length = static_cast<size_t>(fileSize.QuadPart);
+        if (length == 0) return true;
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) { close(); return false; }
+        begin = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (begin == nullptr) { close(); return false; }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) { close(); return false; }
+        length = static_cast<size_t>(info.st_size);
+        if (length == 0) return true;
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) { close(); return false; }
+        begin = static_cast<const char*>(mapped);
+        madvise(mapped, length, MADV_SEQUENTIAL);
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (begin != nullptr) UnmapViewOfFile(begin);
+        if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (begin != nullptr) munmap(const_cast<char*>(begin), length);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        begin = nullptr;
+        length = 0;
+    }
+
+    const char* data() const { return begin; }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(begin, length); }
+
+    // Calls fn(std::string_view) for every non-empty line, without the line ending
+    template<typename Fn>
+    static void forEachLine(std::string_view text, Fn fn) {
+        const char* cursor = text.data();
+        const char* end = text.data() + text.size();
+        while (cursor < end) {
+            const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+            const char* lineEnd = (newline != nullptr) ? newline : end;
+            size_t lineLength = lineEnd - cursor;
+            if (lineLength > 0 && cursor[lineLength - 1] == '\r') lineLength--;
+            if (lineLength > 0) fn(std::string_view(cursor, lineLength));
+            cursor = lineEnd + 1;
+        }
+    }
+
+    template<typename Fn>
+    void forEachLine(Fn fn) const {
+        forEachLine(view(), fn);
+    }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,674 @@
+// Benchmarks for the data-structure and persistence changes. Each section times the
+// current code against a copy of the code it replaced, kept here so the comparison
+// can be re-run after the original is gone from hotel_system.h.
+//
+// Build and run (like test.cpp; add -DCROW_USE_BOOST where Crow needs Boost.Asio):
+//   g++ bench.cpp -o bench.exe -std=c++17 -O2 -pthread -lws2_32 -lwsock32
+//   ./bench.exe [section ...]        (all sections when none are named)
+// Sections: rooms, hash, parse, snapshot, json, contention
+// Sections that need files work in a scratch directory under the system temp dir.
+#define CROW_MAIN
+#include "crow_all.h"
+#include "hotel_system.h"
+#include "HotelManager.h"
+#include "JsonWriter.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+template<typename Fn>
+double secondsFor(Fn fn) {
+    auto start = BenchClock::now();
+    fn();
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+// Keeps results alive so the optimizer can't drop the timed work
+long long sink = 0;
+
+Room benchRoom(int roomNumber) {
+    return Room(roomNumber, static_cast<RoomType>(roomNumber % ROOM_TYPE_COUNT), 1000.0 + roomNumber % 500,
+                RoomStatus::Available, roomNumber / 100, "AC, TV, WiFi");
+}
+
+// ==================== ROOMS: RoomIndex vs the old RoomBST ====================
+
+// The unbalanced tree RoomIndex replaced, reduced to insert and search
+class LegacyRoomBST {
+private:
+    struct Node {
+        Room room;
+        Node* left;
+        Node* right;
+        Node(Room r) : room(r), left(nullptr), right(nullptr) {}
+    };
+
+    Node* root;
+    Node* largest;
+
+    Node* insertHelper(Node* node, const Room& room) {
+        if (node == nullptr) return new Node(room);
+        if (room.roomNumber < node->room.roomNumber) {
+            node->left = insertHelper(node->left, room);
+        } else if (room.roomNumber > node->room.roomNumber) {
+            node->right = insertHelper(node->right, room);
+        }
+        return node;
+    }
+
+public:
+    LegacyRoomBST() : root(nullptr), largest(nullptr) {}
+
+    ~LegacyRoomBST() {
+        std::vector<Node*> pending;
+        if (root != nullptr) pending.push_back(root);
+        while (!pending.empty()) {
+            Node* node = pending.back();
+            pending.pop_back();
+            if (node->left != nullptr) pending.push_back(node->left);
+            if (node->right != nullptr) pending.push_back(node->right);
+            delete node;
+        }
+    }
+
+    // The original recursive insert: O(depth), and rooms arrive in ascending order
+    void insert(const Room& room) {
+        root = insertHelper(root, room);
+    }
+
+    // Builds the same right-leaning chain insert() produces for ascending rooms, in
+    // O(1) per room, so the large trees can be built at all
+    void insertLargest(const Room& room) {
+        Node* node = new Node(room);
+        if (root == nullptr) {
+            root = node;
+        } else {
+            largest->right = node;
+        }
+        largest = node;
+    }
+
+    // The original search, made iterative: the recursive one overflows the stack
+    // on a chain of a million rooms
+    const Room* search(int roomNumber) const {
+        Node* node = root;
+        while (node != nullptr && node->room.roomNumber != roomNumber) {
+            node = roomNumber < node->room.roomNumber ? node->left : node->right;
+        }
+        return node != nullptr ? &node->room : nullptr;
+    }
+};
+
+void benchRooms() {
+    std::printf("\n[rooms] lookup by room number, rooms inserted in ascending order\n");
+    std::printf("%10s %14s %14s %16s %16s\n", "rooms", "index build", "BST build",
+                "index ns/lookup", "BST ns/lookup");
+
+    for (int count : {1000, 100000, 1000000}) {
+        const int firstRoom = 100;
+        std::mt19937 random(count);
+
+        RoomIndex index;
+        double indexBuild = secondsFor([&]() {
+            index.reserve(count);
+            for (int i = 0; i < count; i++) index.insert(benchRoom(firstRoom + i));
+        });
+
+        // The real insert is quadratic on this input; past 1k rooms it would run for hours
+        LegacyRoomBST tree;
+        double treeBuild = secondsFor([&]() {
+            for (int i = 0; i < count; i++) {
+                if (count <= 1000) {
+                    tree.insert(benchRoom(firstRoom + i));
+                } else {
+                    tree.insertLargest(benchRoom(firstRoom + i));
+                }
+            }
+        });
+
+        const int indexLookups = 1000000;
+        std::vector<int> keys(indexLookups);
+        for (int& key : keys) key = firstRoom + (int)(random() % count);
+        double indexTime = secondsFor([&]() {
+            for (int key : keys) sink += index.search(key)->floor;
+        });
+
+        // Fewer lookups on the tree, which walks half the chain per lookup
+        int treeLookups = std::max(200, 200000000 / count);
+        double treeTime = secondsFor([&]() {
+            for (int i = 0; i < treeLookups; i++) sink += tree.search(keys[i % indexLookups])->floor;
+        });
+
+        char treeBuildText[32];
+        if (count <= 1000) {
+            std::snprintf(treeBuildText, sizeof(treeBuildText), "%.2f ms", treeBuild * 1e3);
+        } else {
+            std::snprintf(treeBuildText, sizeof(treeBuildText), "(%.0f ms)", treeBuild * 1e3);
+        }
+        std::printf("%10d %11.2f ms %14s %16.1f %16.1f\n", count, indexBuild * 1e3, treeBuildText,
+                    indexTime * 1e9 / indexLookups, treeTime * 1e9 / treeLookups);
+    }
+    std::printf("BST build in parentheses: chain linked directly; insert() is O(n^2) there\n");
+}
+
+// ==================== HASH: HashTable vs std::unordered_map ====================
+
+// The fixed 100-bucket chained table HashTable replaced, reduced to insert and search
+template<typename T>
+class LegacyHashTable {
+private:
+    struct Node {
+        std::string key;
+        T value;
+        Node* next;
+    };
+
+    static const int TABLE_SIZE = 100;
+    Node* table[TABLE_SIZE] = {};
+
+    int hashFunction(const std::string& key) {
+        int hash = 0;
+        for (char c : key) {
+            hash = (hash * 31 + c) % TABLE_SIZE;
+        }
+        return hash;
+    }
+
+public:
+    LegacyHashTable() {}
+
+    ~LegacyHashTable() {
+        for (Node* node : table) {
+            while (node != nullptr) {
+                Node* next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    void insert(const std::string& key, const T& value) {
+        Node** link = &table[hashFunction(key)];
+        while (*link != nullptr) {
+            if ((*link)->key == key) {
+                (*link)->value = value;
+                return;
+            }
+            link = &(*link)->next;
+        }
+        *link = new Node{key, value, nullptr};
+    }
+
+    T* search(const std::string& key) {
+        for (Node* node = table[hashFunction(key)]; node != nullptr; node = node->next) {
+            if (node->key == key) return &node->value;
+        }
+        return nullptr;
+    }
+};
+
+// std::unordered_map behind the same insert/search calls
+struct StdMapTable {
+    std::unordered_map<std::string, int> map;
+
+    void insert(const std::string& key, int value) { map[key] = value; }
+
+    int* search(const std::string& key) {
+        auto it = map.find(key);
+        return it != map.end() ? &it->second : nullptr;
+    }
+};
+
+struct HashTimes {
+    double insert = 0, worstInsert = 0, hit = 0, miss = 0;
+};
+
+// Inserts every key (timing each one for the worst case), then looks up every key
+// and as many absent ones
+template<typename Table, typename Find>
+HashTimes timeTable(Table& table, const std::vector<std::string>& keys,
+                    const std::vector<std::string>& absent, Find find) {
+    HashTimes times;
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto start = BenchClock::now();
+        table.insert(keys[i], (int)i);
+        double elapsed = std::chrono::duration<double>(BenchClock::now() - start).count();
+        times.insert += elapsed;
+        times.worstInsert = std::max(times.worstInsert, elapsed);
+    }
+    times.hit = secondsFor([&]() {
+        for (const auto& key : keys) sink += *find(table, key);
+    });
+    times.miss = secondsFor([&]() {
+        for (const auto& key : absent) sink += find(table, key) == nullptr;
+    });
+    return times;
+}
+
+void benchHash() {
+    std::printf("\n[hash] user ids -> int: ns per insert / hit / miss, worst single insert in us\n");
+    std::printf("%10s  %-22s %10s %10s %10s %12s\n", "keys", "table", "insert", "hit", "miss", "worst insert");
+
+    for (int count : {1000, 10000, 100000, 1000000}) {
+        std::vector<std::string> keys, absent;
+        for (int i = 0; i < count; i++) {
+            keys.push_back("guest" + std::to_string(i * 7919));
+            absent.push_back("visitor" + std::to_string(i * 7919));
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(count));
+
+        auto report = [&](const char* name, const HashTimes& times) {
+            std::printf("%10d  %-22s %10.1f %10.1f %10.1f %12.1f\n", count, name, times.insert * 1e9 / count,
+                        times.hit * 1e9 / count, times.miss * 1e9 / count, times.worstInsert * 1e6);
+        };
+
+        {
+            HashTable<int> table;
+            report("HashTable", timeTable(table, keys, absent,
+                                          [](HashTable<int>& t, const std::string& key) { return t.search(key); }));
+        }
+        {
+            StdMapTable table;
+            report("std::unordered_map", timeTable(table, keys, absent,
+                                                   [](StdMapTable& t, const std::string& key) { return t.search(key); }));
+        }
+        // Chains average count/100 nodes; a million keys would take hours to insert
+        if (count <= 100000) {
+            LegacyHashTable<int> table;
+            report("old 100-bucket table", timeTable(table, keys, absent,
+                                                     [](LegacyHashTable<int>& t, const std::string& key) {
+                                                         return t.search(key);
+                                                     }));
+        }
+    }
+}
+
+// ==================== PARSE: FieldReader vs stringstream splitting ====================
+
+// Booking as the old parser built it: status kept as a string, every field split
+// into a temporary vector through a stringstream, numbers via stoi/stod
+struct LegacyBooking {
+    int bookingId = 0;
+    std::string userId;
+    int roomNumber = 0;
+    std::string checkInDate;
+    std::string checkOutDate;
+    int nights = 0;
+    double totalAmount = 0.0;
+    std::string status;
+    std::string bookingDate;
+
+    static LegacyBooking fromFileString(const std::string& line) {
+        std::stringstream ss(line);
+        std::string token;
+        std::vector<std::string> tokens;
+        while (std::getline(ss, token, '|')) {
+            tokens.push_back(token);
+        }
+
+        LegacyBooking booking;
+        if (tokens.size() >= 9) {
+            booking.bookingId = std::stoi(tokens[0]);
+            booking.userId = tokens[1];
+            booking.roomNumber = std::stoi(tokens[2]);
+            booking.checkInDate = tokens[3];
+            booking.checkOutDate = tokens[4];
+            booking.nights = std::stoi(tokens[5]);
+            booking.totalAmount = std::stod(tokens[6]);
+            booking.status = tokens[7];
+            booking.bookingDate = tokens[8];
+        }
+        return booking;
+    }
+};
+
+std::filesystem::path scratchDirectory() {
+    std::filesystem::path scratch = std::filesystem::temp_directory_path() / "hotel_bench";
+    std::filesystem::create_directories(scratch);
+    return scratch;
+}
+
+// Day 0, 1, 2... as "YYYY-MM-DD" from 2027-01-01, counting only the 1st to the 28th
+// of each month so every day number is a valid date
+std::string benchDate(int day) {
+    char text[24];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", 2027 + day / 336, day / 28 % 12 + 1, day % 28 + 1);
+    return text;
+}
+
+// `count` bookings spread over 1000 rooms, each room's stays one night apart
+std::vector<Booking> benchBookings(int count) {
+    std::vector<Booking> bookings;
+    bookings.reserve(count);
+    for (int i = 0; i < count; i++) {
+        int checkIn = i / 1000 * 2;
+        bookings.push_back(Booking(1000 + i, "guest" + std::to_string(i % 5000), 100 + i % 1000,
+                                   benchDate(checkIn), benchDate(checkIn + 1), 1,
+                                   1499.5, static_cast<BookingStatus>(i % BOOKING_STATUS_COUNT),
+                                   "17/10/2026 12:00"));
+    }
+    return bookings;
+}
+
+void benchParse() {
+    const int count = 1000000;
+    std::printf("\n[parse] %d bookings from bookings.dat, one thread\n", count);
+
+    std::filesystem::path file = scratchDirectory() / "bookings.dat";
+    {
+        std::ofstream out(file, std::ios::binary);
+        for (const auto& booking : benchBookings(count)) out << booking.toFileString() << '\n';
+    }
+    std::string text;
+    {
+        std::ifstream in(file, std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::vector<std::string> lines;
+    MappedFile::forEachLine(text, [&](std::string_view line) { lines.emplace_back(line); });
+
+    double oldParse = secondsFor([&]() {
+        for (const auto& line : lines) sink += LegacyBooking::fromFileString(line).roomNumber;
+    });
+    double newParse = secondsFor([&]() {
+        for (const auto& line : lines) sink += Booking::fromFileString(line).roomNumber;
+    });
+
+    // The whole load as each version did it: getline from an ifstream, vs a
+    // mapped file split in place
+    double oldLoad = secondsFor([&]() {
+        std::ifstream in(file);
+        std::string line;
+        std::vector<LegacyBooking> bookings;
+        while (std::getline(in, line)) {
+            if (!line.empty()) bookings.push_back(LegacyBooking::fromFileString(line));
+        }
+        sink += bookings.size();
+    });
+    double newLoad = secondsFor([&]() {
+        MappedFile mapped;
+        if (!mapped.open(file.string())) return;
+        std::vector<Booking> bookings;
+        mapped.forEachLine([&](std::string_view line) { bookings.push_back(Booking::fromFileString(line)); });
+        sink += bookings.size();
+    });
+
+    std::printf("%-34s %10s %10s\n", "", "old", "new");
+    std::printf("%-34s %10.1f %10.1f\n", "parse only, ns/record", oldParse * 1e9 / count, newParse * 1e9 / count);
+    std::printf("%-34s %10.0f %10.0f\n", "read file + parse, ms", oldLoad * 1e3, newLoad * 1e3);
+    std::filesystem::remove(file);
+}
+
+// ==================== SNAPSHOT: binary vs text load ====================
+
+void writeFile(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+}
+
+template<typename Record>
+std::string fileLines(const std::vector<Record>& records) {
+    std::string text;
+    for (const auto& record : records) {
+        text += record.toFileString();
+        text += '\n';
+    }
+    return text;
+}
+
+template<typename Record>
+size_t parseFile(const std::filesystem::path& path) {
+    MappedFile file;
+    if (!file.open(path.string())) return 0;
+    std::vector<Record> records;
+    file.forEachLine([&](std::string_view line) { records.push_back(Record::fromFileString(line)); });
+    return records.size();
+}
+
+void benchSnapshot() {
+    SnapshotData data;
+    for (int i = 0; i < 1000; i++) data.rooms.push_back(benchRoom(100 + i));
+    for (int i = 0; i < 10000; i++) {
+        std::string id = "guest" + std::to_string(i);
+        data.users.push_back(User(id, "secret", "Guest " + std::to_string(i), id + "@hotel.com", "1234567890", "user"));
+    }
+    data.bookings = benchBookings(1000000);
+    for (int i = 0; i < 100000; i++) {
+        FoodOrder order;
+        order.orderId = 1000 + i;
+        order.userId = "guest" + std::to_string(i % 10000);
+        order.roomNumber = 100 + i % 1000;
+        order.items = {{"Masala Dosa", 2}, {"Coffee", 1}};
+        order.totalPrice = 350.0;
+        order.status = static_cast<OrderStatus>(i % ORDER_STATUS_COUNT);
+        order.orderTime = "17/10/2026 09:15";
+        data.orders.push_back(order);
+    }
+    for (int i = 0; i < 10000; i++) {
+        data.requests.push_back(ServiceRequest(1000 + i, 100 + i % 1000, static_cast<ServiceType>(i % SERVICE_TYPE_COUNT),
+                                               "Extra towels", 1 + i % 5, ServiceStatus::Pending, "17/10/2026 10:30", ""));
+    }
+    std::printf("\n[snapshot] %zu rooms, %zu users, %zu bookings, %zu orders, %zu service requests\n",
+                data.rooms.size(), data.users.size(), data.bookings.size(), data.orders.size(), data.requests.size());
+
+    std::filesystem::path scratch = scratchDirectory();
+    std::filesystem::path textDir = scratch / "text";
+    std::filesystem::path binaryDir = scratch / "binary";
+    std::filesystem::remove_all(textDir);
+    std::filesystem::remove_all(binaryDir);
+    std::filesystem::create_directories(textDir / "data");
+    std::filesystem::create_directories(binaryDir / "data");
+
+    writeFile(textDir / "data/rooms.dat", fileLines(data.rooms));
+    writeFile(textDir / "data/users.dat", fileLines(data.users));
+    writeFile(textDir / "data/bookings.dat", fileLines(data.bookings));
+    writeFile(textDir / "data/orders.dat", fileLines(data.orders));
+    writeFile(textDir / "data/requests.dat", fileLines(data.requests));
+    writeFile(textDir / "data/snapshot.format", "text\n");
+    writeFile(binaryDir / "data/hotel.snap", SnapshotWriter().serialize(data));
+    writeFile(binaryDir / "data/snapshot.format", "binary\n");
+
+    uintmax_t textBytes = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(textDir / "data")) {
+        if (entry.path().extension() == ".dat") textBytes += entry.file_size();
+    }
+    uintmax_t binaryBytes = std::filesystem::file_size(binaryDir / "data/hotel.snap");
+
+    // Decoding alone, one thread each
+    double textDecode = secondsFor([&]() {
+        sink += parseFile<Room>(textDir / "data/rooms.dat");
+        sink += parseFile<User>(textDir / "data/users.dat");
+        sink += parseFile<Booking>(textDir / "data/bookings.dat");
+        sink += parseFile<FoodOrder>(textDir / "data/orders.dat");
+        sink += parseFile<ServiceRequest>(textDir / "data/requests.dat");
+    });
+    double binaryDecode = secondsFor([&]() {
+        MappedFile file;
+        SnapshotData decoded;
+        std::string error;
+        if (file.open((binaryDir / "data/hotel.snap").string()) && SnapshotReader().read(file.view(), decoded, error)) {
+            sink += decoded.bookings.size();
+        }
+    });
+
+    // Full HotelManager startup, which also rebuilds the calendar and indexes
+    std::filesystem::path home = std::filesystem::current_path();
+    auto startup = [&](const std::filesystem::path& dir, SnapshotFormat format) {
+        std::filesystem::current_path(dir);
+        double seconds = secondsFor([&]() {
+            HotelManager hotel(format);
+            sink += hotel.checkConsistency();
+        });
+        std::filesystem::current_path(home);
+        return seconds;
+    };
+    double textStartup = startup(textDir, SnapshotFormat::Text);
+    double binaryStartup = startup(binaryDir, SnapshotFormat::Binary);
+
+    std::printf("%-30s %10s %10s\n", "", "text", "binary");
+    std::printf("%-30s %10.1f %10.1f\n", "size on disk, MB", textBytes / 1048576.0, binaryBytes / 1048576.0);
+    std::printf("%-30s %10.0f %10.0f\n", "decode, ms", textDecode * 1e3, binaryDecode * 1e3);
+    std::printf("%-30s %10.0f %10.0f\n", "HotelManager startup, ms", textStartup * 1e3, binaryStartup * 1e3);
+    std::filesystem::remove_all(textDir);
+    std::filesystem::remove_all(binaryDir);
+}
+
+// ==================== JSON: JsonWriter vs wvalue trees ====================
+
+// The body of a list endpoint such as /api/bookings/all, built the old way: one
+// toJSON() tree per record, moved into the response, then dumped
+std::string wvalueBody(const std::vector<Booking>& bookings) {
+    std::vector<crow::json::wvalue> jsonBookings;
+    for (const auto& booking : bookings) {
+        jsonBookings.push_back(booking.toJSON());
+    }
+    crow::json::wvalue response;
+    response["bookings"] = std::move(jsonBookings);
+    return response.dump();
+}
+
+std::string writerBody(const std::vector<Booking>& bookings) {
+    std::string body;
+    JsonWriter json(body);
+    json.reserve(bookings.size() * 256);
+    json.beginObject();
+    json.key("bookings");
+    json.beginArray();
+    for (const auto& booking : bookings) {
+        booking.writeJSON(json);
+    }
+    json.endArray();
+    json.endObject();
+    return body;
+}
+
+void benchJson() {
+    std::printf("\n[json] serializing a bookings list endpoint body\n");
+    std::printf("%10s %14s %14s %10s\n", "bookings", "wvalue ms", "writer ms", "body MB");
+
+    // Same records either way (wvalue orders keys differently, so compare parsed)
+    std::vector<Booking> sample = benchBookings(100);
+    auto oldParsed = crow::json::load(wvalueBody(sample));
+    auto newParsed = crow::json::load(writerBody(sample));
+    bool same = oldParsed && newParsed && oldParsed["bookings"].size() == newParsed["bookings"].size();
+    for (size_t i = 0; same && i < sample.size(); i++) {
+        const auto& a = oldParsed["bookings"][i];
+        const auto& b = newParsed["bookings"][i];
+        same = a.size() == b.size() && a["bookingId"].i() == b["bookingId"].i() &&
+               a["userId"].s() == b["userId"].s() && a["checkInDate"].s() == b["checkInDate"].s() &&
+               a["totalAmount"].d() == b["totalAmount"].d() && a["status"].s() == b["status"].s();
+    }
+    if (!same) {
+        std::printf("JsonWriter output doesn't match toJSON()\n");
+        return;
+    }
+
+    for (int count : {1000, 10000, 100000}) {
+        std::vector<Booking> bookings = benchBookings(count);
+        size_t bodySize = 0;
+        double oldTime = secondsFor([&]() { sink += wvalueBody(bookings).size(); });
+        double newTime = secondsFor([&]() { bodySize = writerBody(bookings).size(); });
+        sink += bodySize;
+        std::printf("%10d %14.1f %14.1f %10.1f\n", count, oldTime * 1e3, newTime * 1e3, bodySize / 1048576.0);
+    }
+}
+
+// ==================== CONTENTION: many threads booking a few rooms ====================
+
+// Every thread goes through the same rounds; in round r it books one of a handful
+// of rooms for the nights [3r, 3r + 2). Exactly one booking per room and round must
+// be confirmed and the rest waitlisted, however the threads interleave.
+void benchContention() {
+    const int rooms[] = {101, 102, 103, 104};
+    const int roomCount = sizeof(rooms) / sizeof(rooms[0]);
+    const int rounds = 50;
+    std::printf("\n[contention] threads booking %d rooms for the same nights, %d rounds each\n", roomCount, rounds);
+    std::printf("%10s %10s %12s %12s %10s %10s\n", "threads", "bookings", "bookings/s", "confirmed", "expected", "result");
+
+    std::filesystem::path scratch = scratchDirectory() / "contention";
+    std::filesystem::path home = std::filesystem::current_path();
+
+    for (int threadCount : {1, 16, 64, 256}) {
+        std::filesystem::remove_all(scratch);
+        std::filesystem::create_directories(scratch / "data");
+        std::filesystem::current_path(scratch);
+        {
+            HotelManager hotel;
+
+            // One slot per (round, room): how often it was tried and confirmed
+            struct Slot {
+                std::atomic<int> attempts{0};
+                std::atomic<int> confirmed{0};
+            };
+            std::vector<Slot> slots(rounds * roomCount);
+
+            // Threads wait for each other so they really start together
+            std::atomic<int> ready{0};
+            auto worker = [&](int seed) {
+                std::mt19937 random(seed);
+                std::string userId = "contender" + std::to_string(seed);
+                ready++;
+                while (ready < threadCount) std::this_thread::yield();
+
+                for (int round = 0; round < rounds; round++) {
+                    int room = (int)(random() % roomCount);
+                    Slot& slot = slots[round * roomCount + room];
+                    slot.attempts++;
+                    auto result = crow::json::load(hotel.createBooking(userId, rooms[room], benchDate(round * 3),
+                                                                       benchDate(round * 3 + 2), 2).dump());
+                    if (result && result["success"].b()) slot.confirmed++;
+                }
+            };
+
+            std::vector<std::thread> threads;
+            double seconds = secondsFor([&]() {
+                for (int t = 0; t < threadCount; t++) threads.emplace_back(worker, t + 1);
+                for (auto& thread : threads) thread.join();
+            });
+
+            int confirmations = 0, triedSlots = 0;
+            bool exactlyOne = true;
+            for (const Slot& slot : slots) {
+                confirmations += slot.confirmed;
+                triedSlots += slot.attempts > 0;
+                exactlyOne = exactlyOne && slot.confirmed == (slot.attempts > 0 ? 1 : 0);
+            }
+            bool ok = exactlyOne && hotel.checkConsistency();
+            int bookings = threadCount * rounds;
+            std::printf("%10d %10d %12.0f %12d %10d %10s\n", threadCount, bookings, bookings / seconds,
+                        confirmations, triedSlots, ok ? "ok" : "WRONG");
+        }
+        std::filesystem::current_path(home);
+    }
+    std::filesystem::remove_all(scratch);
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> sections(argv + 1, argv + argc);
+    auto wanted = [&](const std::string& name) {
+        return sections.empty() || std::find(sections.begin(), sections.end(), name) != sections.end();
+    };
+
+    if (wanted("rooms")) benchRooms();
+    if (wanted("hash")) benchHash();
+    if (wanted("parse")) benchParse();
+    if (wanted("snapshot")) benchSnapshot();
+    if (wanted("json")) benchJson();
+    if (wanted("contention")) benchContention();
+
+    std::printf("\n(checksum %lld)\n", sink);
+    return 0;
+}
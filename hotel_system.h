@@ -2,78 +2,369 @@
 #define HOTEL_SYSTEM_H
 
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <charconv>
 #include <vector>
 #include <queue>
+#include <memory>
+#include <set>
+#include <map>
+#include <list>
+#include <unordered_map>
 #include <fstream>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <shared_mutex>
 #include "crow_all.h"
+#include "JsonWriter.h"
 
 // ==================== UTILITY FUNCTIONS ====================
 std::string getCurrentDateTime() {
     time_t now = time(0);
-    tm* ltm = localtime(&now);
+    tm ltm;
+    // localtime() shares a static buffer between threads, use the reentrant variants
+#ifdef _WIN32
+    localtime_s(&ltm, &now);
+#else
+    localtime_r(&now, &ltm);
+#endif
     std::stringstream ss;
     ss << std::setfill('0') 
-       << std::setw(2) << ltm->tm_mday << "/"
-       << std::setw(2) << (1 + ltm->tm_mon) << "/"
-       << (1900 + ltm->tm_year) << " "
-       << std::setw(2) << ltm->tm_hour << ":"
-       << std::setw(2) << ltm->tm_min;
+       << std::setw(2) << ltm.tm_mday << "/"
+       << std::setw(2) << (1 + ltm.tm_mon) << "/"
+       << (1900 + ltm.tm_year) << " "
+       << std::setw(2) << ltm.tm_hour << ":"
+       << std::setw(2) << ltm.tm_min;
     return ss.str();
 }
 
-int generateID() {
-    static int id = 1000;
-    return id++;
+// 64-bit FNV-1a followed by the MurmurHash3 finalizer, so that short keys that
+// differ only in their last characters still spread across all bits
+uint64_t hashString(std::string_view key) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// ==================== ID ALLOCATION ====================
+
+// Hands out ids for one kind of record. Each thread takes a block of BLOCK_SIZE ids
+// from the shared counter with one atomic add and then allocates from it locally, so
+// concurrent creates don't all contend on one cache line. Ids are unique but only
+// roughly ordered across threads, and a block a thread never finishes is skipped.
+//
+// observe() raises the counter past ids already in use (loaded or replayed records),
+// so a restart never reissues one. Call it only while loading, before allocate().
+class IdAllocator {
+private:
+    static const int BLOCK_SIZE = 32;
+    
+    struct Block {
+        uint64_t owner;  // Serial of the allocator the block came from
+        int next;
+        int end;
+    };
+    
+    static std::atomic<uint64_t>& serials() {
+        static std::atomic<uint64_t> counter{0};
+        return counter;
+    }
+    
+    uint64_t serial;  // Never reused, unlike `this`, so stale blocks can't match
+    std::atomic<int> nextFree;
+    
+public:
+    explicit IdAllocator(int firstId = 1000) : serial(++serials()), nextFree(firstId) {}
+    
+    IdAllocator(const IdAllocator&) = delete;
+    IdAllocator& operator=(const IdAllocator&) = delete;
+    
+    void observe(int id) {
+        int current = nextFree.load();
+        while (id >= current && !nextFree.compare_exchange_weak(current, id + 1)) {}
+    }
+    
+    int allocate() {
+        thread_local std::vector<Block> blocks;
+        auto it = std::find_if(blocks.begin(), blocks.end(), [&](const Block& block) { return block.owner == serial; });
+        if (it == blocks.end()) it = blocks.insert(blocks.end(), Block{serial, 0, 0});
+        if (it->next == it->end) {
+            it->next = nextFree.fetch_add(BLOCK_SIZE, std::memory_order_relaxed);
+            it->end = it->next + BLOCK_SIZE;
+        }
+        return it->next++;
+    }
+};
+
+// Parses "YYYY-MM-DD" into a day number (days since 1970-01-01), so stays can be
+// compared and subtracted as plain integers. Rejects anything that isn't a real date.
+bool parseDate(std::string_view text, int& day) {
+    int year = 0, month = 0, dayOfMonth = 0;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return false;
+    auto number = [&](size_t offset, size_t length, int& value) {
+        auto result = std::from_chars(text.data() + offset, text.data() + offset + length, value);
+        return result.ec == std::errc() && result.ptr == text.data() + offset + length;
+    };
+    if (!number(0, 4, year) || !number(5, 2, month) || !number(8, 2, dayOfMonth)) return false;
+    
+    static const int DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (month < 1 || month > 12 || dayOfMonth < 1) return false;
+    if (dayOfMonth > DAYS_IN_MONTH[month - 1] + (month == 2 && leap ? 1 : 0)) return false;
+    
+    // Days from civil date (proleptic Gregorian), counting years from March
+    int y = year - (month <= 2 ? 1 : 0);
+    int era = y / 400;
+    int yearOfEra = y - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + dayOfMonth - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    day = era * 146097 + dayOfEra - 719468;
+    return true;
+}
+
+// ==================== STATUS & TYPE ENUMS ====================
+
+// Statuses and types are stored as one-byte enums and only converted to text at the
+// JSON/file boundary, so the wire format and the .dat files keep the same strings.
+// The name tables are indexed by the enum value and must stay in declaration order.
+
+enum class RoomType : uint8_t { Single, Double, Suite, Deluxe };
+enum class RoomStatus : uint8_t { Available, Occupied, Maintenance, Reserved };
+enum class BookingStatus : uint8_t { Pending, Confirmed, CheckedIn, CheckedOut, Cancelled, Waiting };
+enum class OrderStatus : uint8_t { Pending, Preparing, Delivered, Cancelled };
+enum class ServiceType : uint8_t { Cleaning, Maintenance, RoomService, Emergency };
+enum class ServiceStatus : uint8_t { Pending, InProgress, Completed };
+
+constexpr const char* ROOM_TYPE_NAMES[] = { "Single", "Double", "Suite", "Deluxe" };
+constexpr const char* ROOM_STATUS_NAMES[] = { "Available", "Occupied", "Maintenance", "Reserved" };
+constexpr const char* BOOKING_STATUS_NAMES[] = { "Pending", "Confirmed", "CheckedIn", "CheckedOut",
+                                                 "Cancelled", "Waiting" };
+constexpr const char* ORDER_STATUS_NAMES[] = { "Pending", "Preparing", "Delivered", "Cancelled" };
+constexpr const char* SERVICE_TYPE_NAMES[] = { "Cleaning", "Maintenance", "Room Service", "Emergency" };
+constexpr const char* SERVICE_STATUS_NAMES[] = { "Pending", "InProgress", "Completed" };
+
+constexpr int ROOM_TYPE_COUNT = sizeof(ROOM_TYPE_NAMES) / sizeof(ROOM_TYPE_NAMES[0]);
+constexpr int ROOM_STATUS_COUNT = sizeof(ROOM_STATUS_NAMES) / sizeof(ROOM_STATUS_NAMES[0]);
+constexpr int BOOKING_STATUS_COUNT = sizeof(BOOKING_STATUS_NAMES) / sizeof(BOOKING_STATUS_NAMES[0]);
+constexpr int ORDER_STATUS_COUNT = sizeof(ORDER_STATUS_NAMES) / sizeof(ORDER_STATUS_NAMES[0]);
+constexpr int SERVICE_TYPE_COUNT = sizeof(SERVICE_TYPE_NAMES) / sizeof(SERVICE_TYPE_NAMES[0]);
+constexpr int SERVICE_STATUS_COUNT = sizeof(SERVICE_STATUS_NAMES) / sizeof(SERVICE_STATUS_NAMES[0]);
+
+// Guests each room type sleeps, indexed like RoomType
+constexpr int ROOM_TYPE_CAPACITY[] = { 1, 2, 3, 4 };
+static_assert(sizeof(ROOM_TYPE_CAPACITY) / sizeof(ROOM_TYPE_CAPACITY[0]) == ROOM_TYPE_COUNT,
+              "every room type needs a capacity");
+
+int capacityOf(RoomType type) { return ROOM_TYPE_CAPACITY[static_cast<int>(type)]; }
+
+const char* toString(RoomType value) { return ROOM_TYPE_NAMES[static_cast<int>(value)]; }
+const char* toString(RoomStatus value) { return ROOM_STATUS_NAMES[static_cast<int>(value)]; }
+const char* toString(BookingStatus value) { return BOOKING_STATUS_NAMES[static_cast<int>(value)]; }
+const char* toString(OrderStatus value) { return ORDER_STATUS_NAMES[static_cast<int>(value)]; }
+const char* toString(ServiceType value) { return SERVICE_TYPE_NAMES[static_cast<int>(value)]; }
+const char* toString(ServiceStatus value) { return SERVICE_STATUS_NAMES[static_cast<int>(value)]; }
+
+template<typename Enum, size_t N>
+bool parseEnumName(const char* const (&names)[N], std::string_view text, Enum& out) {
+    for (size_t i = 0; i < N; i++) {
+        if (text == names[i]) {
+            out = static_cast<Enum>(i);
+            return true;
+        }
+    }
+    return false;
 }
 
+// Leave `out` untouched and return false for unknown names
+bool parse(std::string_view text, RoomType& out) { return parseEnumName(ROOM_TYPE_NAMES, text, out); }
+bool parse(std::string_view text, RoomStatus& out) { return parseEnumName(ROOM_STATUS_NAMES, text, out); }
+bool parse(std::string_view text, BookingStatus& out) { return parseEnumName(BOOKING_STATUS_NAMES, text, out); }
+bool parse(std::string_view text, OrderStatus& out) { return parseEnumName(ORDER_STATUS_NAMES, text, out); }
+bool parse(std::string_view text, ServiceType& out) { return parseEnumName(SERVICE_TYPE_NAMES, text, out); }
+bool parse(std::string_view text, ServiceStatus& out) { return parseEnumName(SERVICE_STATUS_NAMES, text, out); }
+
+// ==================== RECORD PARSING ====================
+
+// Text fields are written percent-escaped so user input can never end a record or
+// split a field: '%', '|', '\r' and '\n' (plus any characters in `alsoEscape`) become
+// "%XX". Other bytes are written unchanged, so fields without these characters,
+// which is every field written before escaping existed, read back the same.
+std::string escapeField(std::string_view text, std::string_view alsoEscape = "") {
+    static const char HEX[] = "0123456789ABCDEF";
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '%' || c == '|' || c == '\r' || c == '\n' || alsoEscape.find(c) != std::string_view::npos) {
+            escaped += '%';
+            escaped += HEX[(unsigned char)c >> 4];
+            escaped += HEX[(unsigned char)c & 0xF];
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Reverses escapeField(); a '%' not followed by two hex digits is kept as is
+std::string unescapeField(std::string_view text) {
+    auto hexValue = [](char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    };
+    std::string value;
+    value.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        int high, low;
+        if (text[i] == '%' && i + 2 < text.size() && (high = hexValue(text[i + 1])) >= 0 &&
+            (low = hexValue(text[i + 2])) >= 0) {
+            value += static_cast<char>(high * 16 + low);
+            i += 2;
+        } else {
+            value += text[i];
+        }
+    }
+    return value;
+}
+
+// Fields that end up in .dat lines and journal records are rejected at the API
+// when they hold control characters (escaping keeps the files safe regardless)
+bool hasControlCharacters(std::string_view text) {
+    for (char c : text) {
+        if ((unsigned char)c < 0x20 || c == 0x7F) return true;
+    }
+    return false;
+}
+
+// Walks the '|' separated fields of one .dat/journal record in place. Fields are
+// string_views into the line and numbers go through std::from_chars, so a record
+// is parsed without a stringstream, a token vector or any temporary strings.
+// nextString() undoes escapeField(), copying as is when there is nothing to undo.
+// Every next*() returns false once the fields run out or a number is malformed.
+class FieldReader {
+private:
+    std::string_view rest;
+    char separator;
+    bool exhausted;
+    
+public:
+    explicit FieldReader(std::string_view line, char separator = '|')
+        : rest(line), separator(separator), exhausted(false) {}
+    
+    bool next(std::string_view& field) {
+        if (exhausted) return false;
+        size_t end = rest.find(separator);
+        if (end == std::string_view::npos) {
+            field = rest;
+            exhausted = true;
+        } else {
+            field = rest.substr(0, end);
+            rest.remove_prefix(end + 1);
+        }
+        return true;
+    }
+    
+    bool nextString(std::string& value) {
+        std::string_view field;
+        if (!next(field)) return false;
+        if (field.find('%') == std::string_view::npos) {
+            value.assign(field.data(), field.size());
+        } else {
+            value = unescapeField(field);
+        }
+        return true;
+    }
+    
+    bool nextInt(int& value) {
+        std::string_view field;
+        if (!next(field)) return false;
+        auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == std::errc();
+    }
+    
+    bool nextDouble(double& value) {
+        std::string_view field;
+        if (!next(field)) return false;
+        auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == std::errc();
+    }
+    
+    // Unknown names keep the enum's current (default) value, like the old parser did
+    template<typename Enum>
+    bool nextEnum(Enum& value) {
+        std::string_view field;
+        if (!next(field)) return false;
+        parse(field, value);
+        return true;
+    }
+};
+
 // ==================== CORE DATA CLASSES ====================
 
 class Room {
 public:
     int roomNumber;
-    std::string type;        // "Single", "Double", "Suite", "Deluxe"
+    RoomType type;
+    RoomStatus status;
     double pricePerNight;
-    std::string status;      // "Available", "Occupied", "Maintenance", "Reserved"
     int floor;
     std::string features;    // "AC, TV, WiFi, Mini-bar"
     
-    Room() : roomNumber(0), pricePerNight(0.0), floor(0) {}
+    Room() : roomNumber(0), type(RoomType::Single), status(RoomStatus::Available), pricePerNight(0.0), floor(0) {}
     
-    Room(int num, std::string t, double price, std::string stat, int flr, std::string feat)
-        : roomNumber(num), type(t), pricePerNight(price), status(stat), floor(flr), features(feat) {}
+    Room(int num, RoomType t, double price, RoomStatus stat, int flr, std::string feat)
+        : roomNumber(num), type(t), status(stat), pricePerNight(price), floor(flr), features(feat) {}
     
     crow::json::wvalue toJSON() const {
         crow::json::wvalue json;
         json["roomNumber"] = roomNumber;
-        json["type"] = type;
+        json["type"] = toString(type);
         json["pricePerNight"] = pricePerNight;
-        json["status"] = status;
+        json["status"] = toString(status);
         json["floor"] = floor;
         json["features"] = features;
         return json;
     }
     
+    // Same fields as toJSON(), written without building a wvalue tree
+    void writeJSON(JsonWriter& json) const {
+        json.beginObject();
+        json.field("roomNumber", roomNumber);
+        json.field("type", toString(type));
+        json.field("pricePerNight", pricePerNight);
+        json.field("status", toString(status));
+        json.field("floor", floor);
+        json.field("features", features);
+        json.endObject();
+    }
+    
     std::string toFileString() const {
-        return std::to_string(roomNumber) + "|" + type + "|" + 
-               std::to_string(pricePerNight) + "|" + status + "|" + 
-               std::to_string(floor) + "|" + features;
+        return std::to_string(roomNumber) + "|" + toString(type) + "|" + 
+               std::to_string(pricePerNight) + "|" + toString(status) + "|" + 
+               std::to_string(floor) + "|" + escapeField(features);
     }
     
-    static Room fromFileString(const std::string& line) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, '|')) {
-            tokens.push_back(token);
-        }
+    static Room fromFileString(std::string_view line) {
+        Room room;
+        FieldReader fields(line);
         
-        if (tokens.size() >= 6) {
-            return Room(std::stoi(tokens[0]), tokens[1], std::stod(tokens[2]), 
-                       tokens[3], std::stoi(tokens[4]), tokens[5]);
+        if (fields.nextInt(room.roomNumber) && fields.nextEnum(room.type) &&
+            fields.nextDouble(room.pricePerNight) && fields.nextEnum(room.status) &&
+            fields.nextInt(room.floor) && fields.nextString(room.features)) {
+            return room;
         }
         return Room();
     }
@@ -104,21 +395,29 @@ public:
         return json;
     }
     
+    void writeJSON(JsonWriter& json) const {
+        json.beginObject();
+        json.field("userId", userId);
+        json.field("name", name);
+        json.field("email", email);
+        json.field("phone", phone);
+        json.field("role", role);
+        json.endObject();
+    }
+    
     std::string toFileString() const {
-        return userId + "|" + password + "|" + name + "|" + email + "|" + phone + "|" + role;
+        return escapeField(userId) + "|" + escapeField(password) + "|" + escapeField(name) + "|" +
+               escapeField(email) + "|" + escapeField(phone) + "|" + escapeField(role);
     }
     
-    static User fromFileString(const std::string& line) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, '|')) {
-            tokens.push_back(token);
-        }
+    static User fromFileString(std::string_view line) {
+        User user;
+        FieldReader fields(line);
         
-        if (tokens.size() >= 6) {
-            return User(tokens[0], tokens[1], tokens[2], tokens[3], tokens[4], tokens[5]);
+        if (fields.nextString(user.userId) && fields.nextString(user.password) &&
+            fields.nextString(user.name) && fields.nextString(user.email) &&
+            fields.nextString(user.phone) && fields.nextString(user.role)) {
+            return user;
         }
         return User();
     }
@@ -133,15 +432,18 @@ public:
     std::string checkOutDate;
     int nights;
     double totalAmount;
-    std::string status;  // "Pending", "Confirmed", "CheckedIn", "CheckedOut", "Cancelled"
+    BookingStatus status;
     std::string bookingDate;
+    bool anyRoomOfType;  // While Waiting: any free room of roomNumber's type will do
     
-    Booking() : bookingId(0), roomNumber(0), nights(0), totalAmount(0.0) {}
+    Booking() : bookingId(0), roomNumber(0), nights(0), totalAmount(0.0), status(BookingStatus::Pending),
+                anyRoomOfType(false) {}
     
     Booking(int id, std::string uid, int room, std::string cin, std::string cout, 
-            int n, double amt, std::string stat, std::string bdate)
+            int n, double amt, BookingStatus stat, std::string bdate, bool anyRoom = false)
         : bookingId(id), userId(uid), roomNumber(room), checkInDate(cin), 
-          checkOutDate(cout), nights(n), totalAmount(amt), status(stat), bookingDate(bdate) {}
+          checkOutDate(cout), nights(n), totalAmount(amt), status(stat), bookingDate(bdate),
+          anyRoomOfType(anyRoom) {}
     
     crow::json::wvalue toJSON() const {
         crow::json::wvalue json;
@@ -152,30 +454,47 @@ public:
         json["checkOutDate"] = checkOutDate;
         json["nights"] = nights;
         json["totalAmount"] = totalAmount;
-        json["status"] = status;
+        json["status"] = toString(status);
         json["bookingDate"] = bookingDate;
+        json["anyRoomOfType"] = anyRoomOfType;
         return json;
     }
     
+    void writeJSON(JsonWriter& json) const {
+        json.beginObject();
+        json.field("bookingId", bookingId);
+        json.field("userId", userId);
+        json.field("roomNumber", roomNumber);
+        json.field("checkInDate", checkInDate);
+        json.field("checkOutDate", checkOutDate);
+        json.field("nights", nights);
+        json.field("totalAmount", totalAmount);
+        json.field("status", toString(status));
+        json.field("bookingDate", bookingDate);
+        json.field("anyRoomOfType", anyRoomOfType);
+        json.endObject();
+    }
+    
     std::string toFileString() const {
-        return std::to_string(bookingId) + "|" + userId + "|" + std::to_string(roomNumber) + "|" +
-               checkInDate + "|" + checkOutDate + "|" + std::to_string(nights) + "|" +
-               std::to_string(totalAmount) + "|" + status + "|" + bookingDate;
+        return std::to_string(bookingId) + "|" + escapeField(userId) + "|" + std::to_string(roomNumber) + "|" +
+               escapeField(checkInDate) + "|" + escapeField(checkOutDate) + "|" + std::to_string(nights) + "|" +
+               std::to_string(totalAmount) + "|" + toString(status) + "|" + bookingDate +
+               (anyRoomOfType ? "|AnyRoom" : "");
     }
     
-    static Booking fromFileString(const std::string& line) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, '|')) {
-            tokens.push_back(token);
-        }
+    static Booking fromFileString(std::string_view line) {
+        Booking booking;
+        FieldReader fields(line);
         
-        if (tokens.size() >= 9) {
-            return Booking(std::stoi(tokens[0]), tokens[1], std::stoi(tokens[2]), 
-                          tokens[3], tokens[4], std::stoi(tokens[5]), 
-                          std::stod(tokens[6]), tokens[7], tokens[8]);
+        if (fields.nextInt(booking.bookingId) && fields.nextString(booking.userId) &&
+            fields.nextInt(booking.roomNumber) && fields.nextString(booking.checkInDate) &&
+            fields.nextString(booking.checkOutDate) && fields.nextInt(booking.nights) &&
+            fields.nextDouble(booking.totalAmount) && fields.nextEnum(booking.status) &&
+            fields.nextString(booking.bookingDate)) {
+            // Optional trailing flag, so lines written before it existed still parse
+            std::string_view flag;
+            booking.anyRoomOfType = fields.next(flag) && flag == "AnyRoom";
+            return booking;
         }
         return Booking();
     }
@@ -188,10 +507,10 @@ public:
     int roomNumber;
     std::vector<std::pair<std::string, int>> items; // item name, quantity
     double totalPrice;
-    std::string status;  // "Pending", "Preparing", "Delivered", "Cancelled"
+    OrderStatus status;
     std::string orderTime;
     
-    FoodOrder() : orderId(0), roomNumber(0), totalPrice(0.0) {}
+    FoodOrder() : orderId(0), roomNumber(0), totalPrice(0.0), status(OrderStatus::Pending) {}
     
     crow::json::wvalue toJSON() const {
         crow::json::wvalue json;
@@ -199,7 +518,7 @@ public:
         json["userId"] = userId;
         json["roomNumber"] = roomNumber;
         json["totalPrice"] = totalPrice;
-        json["status"] = status;
+        json["status"] = toString(status);
         json["orderTime"] = orderTime;
         
         std::vector<crow::json::wvalue> itemsJson;
@@ -214,14 +533,72 @@ public:
         return json;
     }
     
+    void writeJSON(JsonWriter& json) const {
+        json.beginObject();
+        json.field("orderId", orderId);
+        json.field("userId", userId);
+        json.field("roomNumber", roomNumber);
+        json.field("totalPrice", totalPrice);
+        json.field("status", toString(status));
+        json.field("orderTime", orderTime);
+        if (json.wants("items")) {
+            json.key("items");
+            json.beginArray();
+            for (const auto& item : items) {
+                json.beginObject();
+                json.key("name");
+                json.value(item.first);
+                json.key("quantity");
+                json.value(item.second);
+                json.endObject();
+            }
+            json.endArray();
+        }
+        json.endObject();
+    }
+    
     std::string toFileString() const {
         std::string itemsStr;
         for (size_t i = 0; i < items.size(); i++) {
-            itemsStr += items[i].first + ":" + std::to_string(items[i].second);
+            itemsStr += escapeField(items[i].first, ",:") + ":" + std::to_string(items[i].second);
             if (i < items.size() - 1) itemsStr += ",";
         }
-        return std::to_string(orderId) + "|" + userId + "|" + std::to_string(roomNumber) + "|" +
-               itemsStr + "|" + std::to_string(totalPrice) + "|" + status + "|" + orderTime;
+        return std::to_string(orderId) + "|" + escapeField(userId) + "|" + std::to_string(roomNumber) + "|" +
+               itemsStr + "|" + std::to_string(totalPrice) + "|" + toString(status) + "|" + orderTime;
+    }
+    
+    // Items are "name:qty,name:qty" with ',' and ':' escaped inside names; the
+    // quantity follows the last ':' of each item, so older unescaped names with ':'
+    // still parse
+    static std::vector<std::pair<std::string, int>> parseItems(std::string_view itemsStr) {
+        std::vector<std::pair<std::string, int>> result;
+        if (itemsStr.empty()) return result;
+        
+        FieldReader items(itemsStr, ',');
+        std::string_view item;
+        while (items.next(item)) {
+            size_t colon = item.rfind(':');
+            if (colon == std::string_view::npos) continue;
+            int quantity = 0;
+            std::from_chars(item.data() + colon + 1, item.data() + item.size(), quantity);
+            result.emplace_back(unescapeField(item.substr(0, colon)), quantity);
+        }
+        return result;
+    }
+    
+    static FoodOrder fromFileString(std::string_view line) {
+        FoodOrder order;
+        FieldReader fields(line);
+        std::string_view itemsStr;
+        
+        if (fields.nextInt(order.orderId) && fields.nextString(order.userId) &&
+            fields.nextInt(order.roomNumber) && fields.next(itemsStr) &&
+            fields.nextDouble(order.totalPrice) && fields.nextEnum(order.status) &&
+            fields.nextString(order.orderTime)) {
+            order.items = parseItems(itemsStr);
+            return order;
+        }
+        return FoodOrder();
     }
 };
 
@@ -229,37 +606,51 @@ class ServiceRequest {
 public:
     int requestId;
     int roomNumber;
-    std::string type;      // "Cleaning", "Maintenance", "Room Service", "Emergency"
-    std::string description;
+    ServiceType type;
+    ServiceStatus status;
     int priority;          // 1=High, 2=Medium, 3=Low
-    std::string status;    // "Pending", "InProgress", "Completed"
+    std::string description;
     std::string requestTime;
     std::string assignedTo;
     
-    ServiceRequest() : requestId(0), roomNumber(0), priority(3) {}
+    ServiceRequest() : requestId(0), roomNumber(0), type(ServiceType::Cleaning), 
+                       status(ServiceStatus::Pending), priority(3) {}
     
-    ServiceRequest(int id, int room, std::string t, std::string desc, int pri, 
-                   std::string stat, std::string time, std::string assigned)
-        : requestId(id), roomNumber(room), type(t), description(desc), 
-          priority(pri), status(stat), requestTime(time), assignedTo(assigned) {}
+    ServiceRequest(int id, int room, ServiceType t, std::string desc, int pri, 
+                   ServiceStatus stat, std::string time, std::string assigned)
+        : requestId(id), roomNumber(room), type(t), status(stat), priority(pri), 
+          description(desc), requestTime(time), assignedTo(assigned) {}
     
     crow::json::wvalue toJSON() const {
         crow::json::wvalue json;
         json["requestId"] = requestId;
         json["roomNumber"] = roomNumber;
-        json["type"] = type;
+        json["type"] = toString(type);
         json["description"] = description;
         json["priority"] = priority;
-        json["status"] = status;
+        json["status"] = toString(status);
         json["requestTime"] = requestTime;
         json["assignedTo"] = assignedTo;
         return json;
     }
     
     std::string toFileString() const {
-        return std::to_string(requestId) + "|" + std::to_string(roomNumber) + "|" + type + "|" +
-               description + "|" + std::to_string(priority) + "|" + status + "|" + 
-               requestTime + "|" + assignedTo;
+        return std::to_string(requestId) + "|" + std::to_string(roomNumber) + "|" + toString(type) + "|" +
+               escapeField(description) + "|" + std::to_string(priority) + "|" + toString(status) + "|" + 
+               requestTime + "|" + escapeField(assignedTo);
+    }
+    
+    static ServiceRequest fromFileString(std::string_view line) {
+        ServiceRequest request;
+        FieldReader fields(line);
+        
+        if (fields.nextInt(request.requestId) && fields.nextInt(request.roomNumber) &&
+            fields.nextEnum(request.type) && fields.nextString(request.description) &&
+            fields.nextInt(request.priority) && fields.nextEnum(request.status) &&
+            fields.nextString(request.requestTime) && fields.nextString(request.assignedTo)) {
+            return request;
+        }
+        return ServiceRequest();
     }
     
     // For priority queue comparison (higher priority = lower number)
@@ -268,328 +659,751 @@ public:
     }
 };
 
-// ==================== DSA: BINARY SEARCH TREE FOR ROOMS ====================
-
-class RoomBSTNode {
-public:
-    Room room;
-    RoomBSTNode* left;
-    RoomBSTNode* right;
-    
-    RoomBSTNode(Room r) : room(r), left(nullptr), right(nullptr) {}
-};
+// ==================== DSA: SORTED ROOM INDEX ====================
 
-class RoomBST {
+// Rooms kept in one contiguous array sorted by room number. Lookups are a binary
+// search, and since room numbers are mostly inserted in ascending order (defaults
+// and rooms.dat are both sorted) inserts are usually a plain push_back.
+// Pointers returned by search() are invalidated by insert() and deleteRoom().
+//
+// Secondary indexes (status, type, type x status -> room numbers) are kept in
+// step with every mutation so filtered queries cost O(result) instead of a full scan.
+// search() is read-only for that reason; changes go through update()/updateRoomStatus().
+class RoomIndex {
 private:
-    RoomBSTNode* root;
+    std::vector<Room> rooms;
+    std::set<int> byStatus[ROOM_STATUS_COUNT];
+    std::set<int> byType[ROOM_TYPE_COUNT];
+    std::set<int> byTypeStatus[ROOM_TYPE_COUNT][ROOM_STATUS_COUNT];
+    std::set<std::pair<double, int>> byTypePrice[ROOM_TYPE_COUNT];  // (price, room), cheapest first
     
-    RoomBSTNode* insertHelper(RoomBSTNode* node, Room room) {
-        if (node == nullptr) {
-            return new RoomBSTNode(room);
-        }
-        
-        if (room.roomNumber < node->room.roomNumber) {
-            node->left = insertHelper(node->left, room);
-        } else if (room.roomNumber > node->room.roomNumber) {
-            node->right = insertHelper(node->right, room);
-        }
-        return node;
+    std::vector<Room>::iterator lowerBound(int roomNumber) {
+        return std::lower_bound(rooms.begin(), rooms.end(), roomNumber,
+                                [](const Room& room, int number) { return room.roomNumber < number; });
     }
     
-    RoomBSTNode* searchHelper(RoomBSTNode* node, int roomNumber) {
-        if (node == nullptr || node->room.roomNumber == roomNumber) {
-            return node;
+    Room* find(int roomNumber) {
+        auto it = lowerBound(roomNumber);
+        if (it != rooms.end() && it->roomNumber == roomNumber) {
+            return &(*it);
         }
-        
-        if (roomNumber < node->room.roomNumber) {
-            return searchHelper(node->left, roomNumber);
-        }
-        return searchHelper(node->right, roomNumber);
+        return nullptr;
     }
     
-    void inorderHelper(RoomBSTNode* node, std::vector<Room>& rooms) {
-        if (node == nullptr) return;
-        inorderHelper(node->left, rooms);
-        rooms.push_back(node->room);
-        inorderHelper(node->right, rooms);
+    std::set<int>& statusSet(RoomStatus status) { return byStatus[static_cast<int>(status)]; }
+    std::set<int>& typeSet(RoomType type) { return byType[static_cast<int>(type)]; }
+    std::set<int>& typeStatusSet(RoomType type, RoomStatus status) {
+        return byTypeStatus[static_cast<int>(type)][static_cast<int>(status)];
     }
     
-    void collectByTypeHelper(RoomBSTNode* node, const std::string& type, std::vector<Room>& rooms) {
-        if (node == nullptr) return;
-        collectByTypeHelper(node->left, type, rooms);
-        if (node->room.type == type) {
-            rooms.push_back(node->room);
-        }
-        collectByTypeHelper(node->right, type, rooms);
+    void addToIndexes(const Room& room) {
+        statusSet(room.status).insert(room.roomNumber);
+        typeSet(room.type).insert(room.roomNumber);
+        typeStatusSet(room.type, room.status).insert(room.roomNumber);
+        byTypePrice[static_cast<int>(room.type)].emplace(room.pricePerNight, room.roomNumber);
     }
     
-    void collectByStatusHelper(RoomBSTNode* node, const std::string& status, std::vector<Room>& rooms) {
-        if (node == nullptr) return;
-        collectByStatusHelper(node->left, status, rooms);
-        if (node->room.status == status) {
-            rooms.push_back(node->room);
-        }
-        collectByStatusHelper(node->right, status, rooms);
-    }
-    
-    RoomBSTNode* deleteHelper(RoomBSTNode* node, int roomNumber) {
-        if (node == nullptr) return nullptr;
-        
-        if (roomNumber < node->room.roomNumber) {
-            node->left = deleteHelper(node->left, roomNumber);
-        } else if (roomNumber > node->room.roomNumber) {
-            node->right = deleteHelper(node->right, roomNumber);
-        } else {
-            // Node found
-            if (node->left == nullptr) {
-                RoomBSTNode* temp = node->right;
-                delete node;
-                return temp;
-            } else if (node->right == nullptr) {
-                RoomBSTNode* temp = node->left;
-                delete node;
-                return temp;
-            }
-            
-            // Two children: Get inorder successor
-            RoomBSTNode* temp = findMin(node->right);
-            node->room = temp->room;
-            node->right = deleteHelper(node->right, temp->room.roomNumber);
-        }
-        return node;
+    void removeFromIndexes(const Room& room) {
+        statusSet(room.status).erase(room.roomNumber);
+        typeSet(room.type).erase(room.roomNumber);
+        typeStatusSet(room.type, room.status).erase(room.roomNumber);
+        byTypePrice[static_cast<int>(room.type)].erase({room.pricePerNight, room.roomNumber});
     }
     
-    RoomBSTNode* findMin(RoomBSTNode* node) {
-        while (node->left != nullptr) {
-            node = node->left;
+    std::vector<Room> collect(const std::set<int>& roomNumbers) {
+        std::vector<Room> result;
+        result.reserve(roomNumbers.size());
+        for (int roomNumber : roomNumbers) {
+            result.push_back(*find(roomNumber));
         }
-        return node;
+        return result;
     }
     
 public:
-    RoomBST() : root(nullptr) {}
+    RoomIndex() {}
     
     void insert(Room room) {
-        root = insertHelper(root, room);
+        if (rooms.empty() || rooms.back().roomNumber < room.roomNumber) {
+            addToIndexes(room);
+            rooms.push_back(std::move(room));
+            return;
+        }
+        auto it = lowerBound(room.roomNumber);
+        if (it != rooms.end() && it->roomNumber == room.roomNumber) {
+            return;  // Duplicate room numbers are ignored
+        }
+        addToIndexes(room);
+        rooms.insert(it, std::move(room));
     }
     
-    Room* search(int roomNumber) {
-        RoomBSTNode* node = searchHelper(root, roomNumber);
-        return (node != nullptr) ? &(node->room) : nullptr;
+    const Room* search(int roomNumber) {
+        return find(roomNumber);
     }
     
     std::vector<Room> getAllRooms() {
-        std::vector<Room> rooms;
-        inorderHelper(root, rooms);
         return rooms;
     }
     
-    std::vector<Room> getRoomsByType(const std::string& type) {
-        std::vector<Room> rooms;
-        collectByTypeHelper(root, type, rooms);
-        return rooms;
+    // Visits rooms in room-number order without copying them
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (const auto& room : rooms) {
+            fn(room);
+        }
     }
     
-    std::vector<Room> getRoomsByStatus(const std::string& status) {
-        std::vector<Room> rooms;
-        collectByStatusHelper(root, status, rooms);
-        return rooms;
+    // Visits the rooms of one type in room-number order
+    template<typename Fn>
+    void forEachOfType(RoomType type, Fn fn) {
+        for (int roomNumber : typeSet(type)) {
+            fn(*find(roomNumber));
+        }
     }
     
-    bool updateRoomStatus(int roomNumber, const std::string& newStatus) {
-        Room* room = search(roomNumber);
+    std::vector<Room> getRoomsByType(RoomType type) {
+        return collect(typeSet(type));
+    }
+    
+    std::vector<Room> getRoomsByStatus(RoomStatus status) {
+        return collect(statusSet(status));
+    }
+    
+    std::vector<Room> getRoomsByTypeAndStatus(RoomType type, RoomStatus status) {
+        return collect(typeStatusSet(type, status));
+    }
+    
+    bool update(int roomNumber, const Room& updatedRoom) {
+        Room* room = find(roomNumber);
+        if (room == nullptr) return false;
+        removeFromIndexes(*room);
+        *room = updatedRoom;
+        room->roomNumber = roomNumber;  // The sort key never changes in place
+        addToIndexes(*room);
+        return true;
+    }
+    
+    bool updateRoomStatus(int roomNumber, RoomStatus newStatus) {
+        Room* room = find(roomNumber);
         if (room != nullptr) {
-            room->status = newStatus;
+            if (room->status != newStatus) {
+                removeFromIndexes(*room);
+                room->status = newStatus;
+                addToIndexes(*room);
+            }
             return true;
         }
         return false;
     }
     
     void deleteRoom(int roomNumber) {
-        root = deleteHelper(root, roomNumber);
+        auto it = lowerBound(roomNumber);
+        if (it != rooms.end() && it->roomNumber == roomNumber) {
+            removeFromIndexes(*it);
+            rooms.erase(it);
+        }
     }
+    
+    int size() const { return (int)rooms.size(); }
+    
+    // Visits rooms of one type from cheapest up (ties by room number) while the price is
+    // at most maxPrice, until fn returns false
+    template<typename Fn>
+    void forEachByPrice(RoomType type, double maxPrice, Fn fn) {
+        for (const auto& entry : byTypePrice[static_cast<int>(type)]) {
+            if (entry.first > maxPrice) return;
+            if (!fn(*find(entry.second))) return;
+        }
+    }
+    
+    int countByStatus(RoomStatus status) const {
+        return (int)byStatus[static_cast<int>(status)].size();
+    }
+    
+    void reserve(size_t count) { rooms.reserve(count); }
 };
 
-// ==================== DSA: HASH TABLE FOR USERS ====================
+// ==================== DSA: RESERVATION CALENDAR ====================
 
-template<typename T>
-class HashNode {
+// Booked stays per room as half-open night ranges [checkIn, checkOut) of day numbers,
+// in a std::map keyed by check-in. A room's stays never overlap, so the only stay
+// that can clash with [from, to) is the last one starting before `to`: every earlier
+// one ends before that one starts. That makes each availability check O(log n) in
+// the room's bookings, and "which of these rooms are free" one such check per room.
+//
+// Rooms are added and removed (addRoom/removeRoom/clear) only under the owner's
+// exclusive lock; every other call may run concurrently under its shared lock. Each
+// room's stays have their own reader/writer lock, so checks share it, and contending
+// reservations for one room are ordered by that lock alone rather than by any lock
+// covering other rooms.
+class ReservationCalendar {
+private:
+    struct Stay {
+        int checkOut;
+        int bookingId;
+        bool checkedIn;
+    };
+    
+    struct RoomStays {
+        std::map<int, Stay> byCheckIn;
+        int checkedIn = 0;  // Stays whose guest is in the room
+        mutable std::shared_mutex mutex;
+    };
+    
+    using ReadClaim = std::shared_lock<std::shared_mutex>;
+    using WriteClaim = std::unique_lock<std::shared_mutex>;
+    
+    std::unordered_map<int, RoomStays> rooms;
+    
+    static bool overlaps(const RoomStays& stays, int from, int to) {
+        auto it = stays.byCheckIn.lower_bound(to);
+        if (it == stays.byCheckIn.begin()) return false;
+        --it;
+        return it->second.checkOut > from;
+    }
+    
+    static Stay* findStay(RoomStays& stays, int checkIn, int bookingId) {
+        auto it = stays.byCheckIn.find(checkIn);
+        if (it == stays.byCheckIn.end() || it->second.bookingId != bookingId) return nullptr;
+        return &it->second;
+    }
+    
 public:
-    std::string key;
-    T value;
-    HashNode* next;
+    void addRoom(int roomNumber) { rooms.try_emplace(roomNumber); }
+    void removeRoom(int roomNumber) { rooms.erase(roomNumber); }
+    
+    bool isFree(int roomNumber, int from, int to) const {
+        auto it = rooms.find(roomNumber);
+        if (it == rooms.end()) return true;
+        ReadClaim claim(it->second.mutex);
+        return !overlaps(it->second, from, to);
+    }
+    
+    // Fails (changing nothing) if the room is unknown, the range is empty or it
+    // overlaps another stay
+    bool reserve(int roomNumber, int from, int to, int bookingId) {
+        if (from >= to) return false;
+        auto it = rooms.find(roomNumber);
+        if (it == rooms.end()) return false;
+        RoomStays& stays = it->second;
+        WriteClaim claim(stays.mutex);
+        if (overlaps(stays, from, to)) return false;
+        stays.byCheckIn.emplace(from, Stay{to, bookingId, false});
+        return true;
+    }
+    
+    bool release(int roomNumber, int checkIn, int bookingId) {
+        auto it = rooms.find(roomNumber);
+        if (it == rooms.end()) return false;
+        RoomStays& stays = it->second;
+        WriteClaim claim(stays.mutex);
+        Stay* stay = findStay(stays, checkIn, bookingId);
+        if (stay == nullptr) return false;
+        if (stay->checkedIn) stays.checkedIn--;
+        stays.byCheckIn.erase(checkIn);
+        return true;
+    }
+    
+    bool markCheckedIn(int roomNumber, int checkIn, int bookingId) {
+        auto it = rooms.find(roomNumber);
+        if (it == rooms.end()) return false;
+        RoomStays& stays = it->second;
+        WriteClaim claim(stays.mutex);
+        Stay* stay = findStay(stays, checkIn, bookingId);
+        if (stay == nullptr || stay->checkedIn) return false;
+        stay->checkedIn = true;
+        stays.checkedIn++;
+        return true;
+    }
     
-    HashNode(std::string k, T v) : key(k), value(v), next(nullptr) {}
+    // Occupied while a guest is checked in, Reserved while stays are booked
+    RoomStatus derivedStatus(int roomNumber) const {
+        auto it = rooms.find(roomNumber);
+        if (it == rooms.end()) return RoomStatus::Available;
+        ReadClaim claim(it->second.mutex);
+        if (it->second.byCheckIn.empty()) return RoomStatus::Available;
+        return it->second.checkedIn > 0 ? RoomStatus::Occupied : RoomStatus::Reserved;
+    }
+    
+    void clear() { rooms.clear(); }
 };
 
+// ==================== DSA: WAITLISTS ====================
+
+// FIFO queues of Waiting booking ids: one per room, and one per room type for guests
+// who will take any room of that type. The bookings themselves live in the booking
+// log (so they are journaled and snapshotted like any other); this is only the order.
+// Every id remembers its queue and list node, so removal (promotion or cancellation)
+// is O(1).
+class Waitlist {
+private:
+    struct Entry {
+        std::list<int>* queue;
+        std::list<int>::iterator node;
+    };
+    
+    std::unordered_map<int, std::list<int>> byRoom;  // Node-based, so list addresses are stable
+    std::list<int> byType[ROOM_TYPE_COUNT];
+    std::unordered_map<int, Entry> entries;
+    
+    void add(std::list<int>& queue, int bookingId) {
+        if (entries.count(bookingId)) return;
+        queue.push_back(bookingId);
+        entries[bookingId] = Entry{&queue, std::prev(queue.end())};
+    }
+    
+    template<typename Fn>
+    static bool walk(std::list<int>& queue, Fn& fn) {
+        for (auto it = queue.begin(); it != queue.end();) {
+            int bookingId = *it++;
+            if (!fn(bookingId)) return false;
+        }
+        return true;
+    }
+    
+    static int positionIn(const std::list<int>& queue, int bookingId) {
+        int position = 1;
+        for (int id : queue) {
+            if (id == bookingId) return position;
+            position++;
+        }
+        return 0;
+    }
+    
+public:
+    void addForRoom(int roomNumber, int bookingId) { add(byRoom[roomNumber], bookingId); }
+    void addForType(RoomType type, int bookingId) { add(byType[static_cast<int>(type)], bookingId); }
+    
+    bool remove(int bookingId) {
+        auto it = entries.find(bookingId);
+        if (it == entries.end()) return false;
+        it->second.queue->erase(it->second.node);
+        entries.erase(it);
+        return true;
+    }
+    
+    // Removes a room's queue, returning its ids oldest first
+    std::vector<int> dropRoom(int roomNumber) {
+        std::vector<int> dropped;
+        auto it = byRoom.find(roomNumber);
+        if (it == byRoom.end()) return dropped;
+        dropped.assign(it->second.begin(), it->second.end());
+        for (int bookingId : dropped) entries.erase(bookingId);
+        byRoom.erase(it);
+        return dropped;
+    }
+    
+    // 1-based place in the booking's queue, or 0 if it isn't waiting
+    int position(int bookingId) const {
+        auto it = entries.find(bookingId);
+        return (it != entries.end()) ? positionIn(*it->second.queue, bookingId) : 0;
+    }
+    
+    // Visits every waiting id with its 1-based place in its queue, numbering each
+    // queue in the same pass: room queues first, then type queues
+    template<typename Fn>
+    void forEachWaiting(Fn fn) const {
+        auto visit = [&](const std::list<int>& queue) {
+            int position = 1;
+            for (int bookingId : queue) fn(bookingId, position++);
+        };
+        for (const auto& entry : byRoom) visit(entry.second);
+        for (const auto& queue : byType) visit(queue);
+    }
+    
+    // Visit one queue oldest first until fn returns false, and say whether the walk
+    // got to the end. The walk steps past an id before handing it to fn, so fn may
+    // remove that id.
+    template<typename Fn>
+    bool forEachWaitingForRoom(int roomNumber, Fn fn) {
+        auto it = byRoom.find(roomNumber);
+        return it == byRoom.end() || walk(it->second, fn);
+    }
+    
+    template<typename Fn>
+    bool forEachWaitingForType(RoomType type, Fn fn) {
+        return walk(byType[static_cast<int>(type)], fn);
+    }
+    
+    size_t size() const { return entries.size(); }
+    
+    void clear() {
+        byRoom.clear();
+        for (auto& queue : byType) queue.clear();
+        entries.clear();
+    }
+};
+
+// ==================== DSA: HASH TABLE FOR USERS ====================
+
+// Open-addressing Robin Hood table. Records live in one dense `entries` array and
+// the power-of-two slot array holds only {probe distance, hash fingerprint, entry
+// index}, so probing stays within a few cache lines and iteration is a linear scan.
+//
+// When the load factor passes MAX_LOAD the slot array doubles, but slots are not
+// all moved at once: the old array is kept and every insert/remove migrates a few
+// of its slots, so no single request pays for rehashing every user. Until the old
+// array is drained, lookups probe the new array first and then the old one. The old
+// array uses tombstones (not backward shift) so the migration cursor stays valid.
+//
+// Pointers returned by search() are invalidated by the next insert() or remove().
 template<typename T>
 class HashTable {
 private:
-    static const int TABLE_SIZE = 100;
-    HashNode<T>* table[TABLE_SIZE];
+    struct Entry {
+        std::string key;
+        T value;
+        uint64_t hash;
+    };
     
-    int hashFunction(const std::string& key) {
-        int hash = 0;
-        for (char c : key) {
-            hash = (hash * 31 + c) % TABLE_SIZE;
+    struct Slot {
+        uint32_t distance = 0;  // Probe distance + 1, 0 = never used
+        uint32_t fingerprint = 0;
+        uint32_t entry = 0;
+        bool live = false;
+    };
+    
+    struct SlotArray {
+        std::vector<Slot> slots;
+        size_t count = 0;
+        
+        size_t mask() const { return slots.size() - 1; }
+    };
+    
+    static const size_t INITIAL_CAPACITY = 64;
+    static const size_t MIGRATE_BATCH = 16;
+    static constexpr double MAX_LOAD = 0.75;
+    
+    std::vector<Entry> entries;
+    SlotArray current;
+    SlotArray old;
+    size_t migratePos = 0;
+    
+    bool migrating() const { return !old.slots.empty(); }
+    
+    template<typename Match>
+    static Slot* probe(SlotArray& table, uint64_t hash, Match match) {
+        if (table.slots.empty()) return nullptr;
+        uint32_t fingerprint = static_cast<uint32_t>(hash);
+        size_t index = (hash >> 32) & table.mask();
+        for (uint32_t distance = 1; ; distance++) {
+            Slot& slot = table.slots[index];
+            if (slot.distance < distance) return nullptr;  // Robin Hood invariant: it would be here
+            if (slot.live && slot.fingerprint == fingerprint && match(slot.entry)) return &slot;
+            index = (index + 1) & table.mask();
         }
-        return hash;
     }
     
-public:
-    HashTable() {
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            table[i] = nullptr;
+    Slot* findKey(SlotArray& table, std::string_view key, uint64_t hash) {
+        return probe(table, hash, [&](uint32_t entry) { return entries[entry].key == key; });
+    }
+    
+    static Slot* findEntry(SlotArray& table, uint64_t hash, uint32_t entry) {
+        return probe(table, hash, [&](uint32_t candidate) { return candidate == entry; });
+    }
+    
+    // Caller guarantees the entry is not present and there is a free slot
+    static void insertSlot(SlotArray& table, uint64_t hash, uint32_t entry) {
+        Slot slot;
+        slot.distance = 1;
+        slot.fingerprint = static_cast<uint32_t>(hash);
+        slot.entry = entry;
+        slot.live = true;
+        size_t index = (hash >> 32) & table.mask();
+        while (true) {
+            Slot& existing = table.slots[index];
+            if (existing.distance == 0) {
+                existing = slot;
+                table.count++;
+                return;
+            }
+            if (existing.distance < slot.distance) {
+                std::swap(existing, slot);
+            }
+            slot.distance++;
+            index = (index + 1) & table.mask();
         }
     }
     
-    void insert(const std::string& key, const T& value) {
-        int index = hashFunction(key);
-        HashNode<T>* newNode = new HashNode<T>(key, value);
-        
-        if (table[index] == nullptr) {
-            table[index] = newNode;
-        } else {
-            HashNode<T>* current = table[index];
-            while (current->next != nullptr) {
-                if (current->key == key) {
-                    current->value = value;
-                    delete newNode;
-                    return;
-                }
-                current = current->next;
+    // Backward-shift deletion keeps the new array free of tombstones
+    static void eraseSlot(SlotArray& table, Slot* slot) {
+        size_t index = slot - table.slots.data();
+        while (true) {
+            size_t next = (index + 1) & table.mask();
+            Slot& following = table.slots[next];
+            if (following.distance <= 1) break;
+            table.slots[index] = following;
+            table.slots[index].distance--;
+            index = next;
+        }
+        table.slots[index] = Slot();
+        table.count--;
+    }
+    
+    static void killSlot(SlotArray& table, Slot* slot) {
+        slot->live = false;
+        table.count--;
+    }
+    
+    void migrateStep(size_t batch) {
+        while (migrating() && batch-- > 0) {
+            Slot& slot = old.slots[migratePos];
+            if (slot.live) {
+                insertSlot(current, entries[slot.entry].hash, slot.entry);
+                killSlot(old, &slot);
             }
-            if (current->key == key) {
-                current->value = value;
-                delete newNode;
-            } else {
-                current->next = newNode;
+            if (++migratePos == old.slots.size()) {
+                old = SlotArray();
+                migratePos = 0;
             }
         }
     }
     
-    T* search(const std::string& key) {
-        int index = hashFunction(key);
-        HashNode<T>* current = table[index];
+    void growIfNeeded() {
+        if (current.count + 1 <= current.slots.size() * MAX_LOAD) return;
+        // A new resize cannot start until the previous one has drained
+        migrateStep(old.slots.size());
+        old = std::move(current);
+        current = SlotArray();
+        current.slots.resize(old.slots.size() * 2);
+        migratePos = 0;
+    }
+    
+    Slot* findSlot(std::string_view key, uint64_t hash, SlotArray*& owner) {
+        owner = &current;
+        if (Slot* slot = findKey(current, key, hash)) return slot;
+        owner = &old;
+        return migrating() ? findKey(old, key, hash) : nullptr;
+    }
+    
+public:
+    HashTable() {
+        current.slots.resize(INITIAL_CAPACITY);
+    }
+    
+    void insert(const std::string& key, const T& value) {
+        uint64_t hash = hashString(key);
+        migrateStep(MIGRATE_BATCH);
         
-        while (current != nullptr) {
-            if (current->key == key) {
-                return &(current->value);
-            }
-            current = current->next;
+        SlotArray* owner;
+        if (Slot* slot = findSlot(key, hash, owner)) {
+            entries[slot->entry].value = value;
+            return;
         }
-        return nullptr;
+        
+        growIfNeeded();
+        entries.push_back(Entry{ key, value, hash });
+        insertSlot(current, hash, static_cast<uint32_t>(entries.size() - 1));
+    }
+    
+    T* search(std::string_view key) {
+        SlotArray* owner;
+        Slot* slot = findSlot(key, hashString(key), owner);
+        return (slot != nullptr) ? &(entries[slot->entry].value) : nullptr;
     }
     
-    bool remove(const std::string& key) {
-        int index = hashFunction(key);
-        HashNode<T>* current = table[index];
-        HashNode<T>* prev = nullptr;
+    bool remove(std::string_view key) {
+        uint64_t hash = hashString(key);
+        migrateStep(MIGRATE_BATCH);
         
-        while (current != nullptr) {
-            if (current->key == key) {
-                if (prev == nullptr) {
-                    table[index] = current->next;
-                } else {
-                    prev->next = current->next;
-                }
-                delete current;
-                return true;
-            }
-            prev = current;
-            current = current->next;
+        SlotArray* owner;
+        Slot* slot = findSlot(key, hash, owner);
+        if (slot == nullptr) return false;
+        
+        uint32_t removed = slot->entry;
+        if (owner == &current) {
+            eraseSlot(current, slot);
+        } else {
+            killSlot(old, slot);
         }
-        return false;
+        
+        // Keep entries dense: move the last entry into the hole and repoint its slot
+        uint32_t last = static_cast<uint32_t>(entries.size() - 1);
+        if (removed != last) {
+            uint64_t lastHash = entries[last].hash;
+            Slot* moved = findEntry(current, lastHash, last);
+            if (moved == nullptr) moved = findEntry(old, lastHash, last);
+            moved->entry = removed;
+            entries[removed] = std::move(entries[last]);
+        }
+        entries.pop_back();
+        return true;
+    }
+    
+    size_t size() const { return entries.size(); }
+    
+    // Pre-sizes an empty table for a bulk load so it never has to grow on the way
+    void reserve(size_t count) {
+        if (!entries.empty() || migrating()) return;
+        size_t capacity = INITIAL_CAPACITY;
+        while (count + 1 > capacity * MAX_LOAD) capacity *= 2;
+        current.slots.assign(capacity, Slot());
+        entries.reserve(count);
     }
     
     std::vector<T> getAllValues() {
         std::vector<T> values;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            HashNode<T>* current = table[i];
-            while (current != nullptr) {
-                values.push_back(current->value);
-                current = current->next;
-            }
+        values.reserve(entries.size());
+        for (const auto& entry : entries) {
+            values.push_back(entry.value);
         }
         return values;
     }
-};
-
-// ==================== DSA: LINKED LIST FOR BOOKINGS/ORDERS ====================
-
-template<typename T>
-class ListNode {
-public:
-    T data;
-    ListNode* next;
     
-    ListNode(T d) : data(d), next(nullptr) {}
+    // Visits values in table order without copying them
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (const auto& entry : entries) {
+            fn(entry.value);
+        }
+    }
 };
 
+// ==================== DSA: CHUNKED RECORD LOG FOR BOOKINGS/ORDERS ====================
+
+// Append-only log stored in fixed-size contiguous chunks. append() is O(1), records
+// never move once written (chunks are only ever added), and iteration walks whole
+// chunks in order. remove() leaves a tombstone that iteration skips.
+//
+// idIndex maps bookingId/orderId to a slot, so lookups are O(1) and hand out a
+// pointer to the stored record itself. userIndex keeps each guest's slots in
+// insertion order, so per-guest queries cost O(that guest's history).
 template<typename T>
-class LinkedList {
+class RecordLog {
 private:
-    ListNode<T>* head;
-    int size;
+    static const int CHUNK_SIZE = 512;
+    
+    struct Slot {
+        T data;
+        bool live = false;
+    };
+    
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    int used;   // Slots handed out, including tombstones
+    int size;   // Live records
+    std::unordered_map<int, int> idIndex;
+    std::unordered_map<std::string, std::vector<int>> userIndex;
+    
+    Slot& slotAt(int position) {
+        return chunks[position / CHUNK_SIZE][position % CHUNK_SIZE];
+    }
     
 public:
-    LinkedList() : head(nullptr), size(0) {}
+    RecordLog() : used(0), size(0) {}
     
-    void append(const T& data) {
-        ListNode<T>* newNode = new ListNode<T>(data);
-        
-        if (head == nullptr) {
-            head = newNode;
-        } else {
-            ListNode<T>* current = head;
-            while (current->next != nullptr) {
-                current = current->next;
-            }
-            current->next = newNode;
+    T& append(const T& data) {
+        if (used == (int)chunks.size() * CHUNK_SIZE) {
+            chunks.emplace_back(new Slot[CHUNK_SIZE]);
         }
+        int position = used++;
+        Slot& slot = slotAt(position);
+        slot.data = data;
+        slot.live = true;
         size++;
+        
+        idIndex[getIdFromData(slot.data)] = position;
+        userIndex[slot.data.userId].push_back(position);
+        return slot.data;
+    }
+    
+    int getSize() { return size; }
+    
+    T* find(int id) {
+        auto it = idIndex.find(id);
+        return (it != idIndex.end()) ? &(slotAt(it->second).data) : nullptr;
     }
     
-    std::vector<T> toVector() {
-        std::vector<T> result;
-        ListNode<T>* current = head;
-        while (current != nullptr) {
-            result.push_back(current->data);
-            current = current->next;
+    template<typename Fn>
+    void forEach(Fn fn) {
+        for (int position = 0; position < used; position++) {
+            Slot& slot = slotAt(position);
+            if (slot.live) fn(slot.data);
         }
-        return result;
     }
     
-    int getSize() { return size; }
+    template<typename Fn>
+    void forEachByUser(const std::string& userId, Fn fn) {
+        auto it = userIndex.find(userId);
+        if (it == userIndex.end()) return;
+        for (int position : it->second) {
+            fn(slotAt(position).data);
+        }
+    }
+    
+    // Paging: a cursor is the id of the last record already seen. Positions never
+    // move, so a page resumes exactly next to it even if ids aren't monotonic.
+    // Returns -1 for an unknown id.
+    int positionOf(int id) {
+        auto it = idIndex.find(id);
+        return (it != idIndex.end()) ? it->second : -1;
+    }
+    
+    // One past the newest position
+    int endPosition() const { return used; }
+    
+    // Visits live records from `position` on, in append order, until fn returns false
+    template<typename Fn>
+    void forEachFrom(int position, Fn fn) {
+        for (; position < used; position++) {
+            Slot& slot = slotAt(position);
+            if (slot.live && !fn(slot.data)) return;
+        }
+    }
+    
+    // Visits live records from `position` back to the oldest, until fn returns false
+    template<typename Fn>
+    void forEachBackFrom(int position, Fn fn) {
+        for (position = std::min(position, used - 1); position >= 0; position--) {
+            Slot& slot = slotAt(position);
+            if (slot.live && !fn(slot.data)) return;
+        }
+    }
+    
+    template<typename Fn>
+    void forEachByUserFrom(const std::string& userId, int position, Fn fn) {
+        auto it = userIndex.find(userId);
+        if (it == userIndex.end()) return;
+        const auto& positions = it->second;
+        for (auto p = std::lower_bound(positions.begin(), positions.end(), position); p != positions.end(); ++p) {
+            if (!fn(slotAt(*p).data)) return;
+        }
+    }
+    
+    template<typename Fn>
+    void forEachByUserBackFrom(const std::string& userId, int position, Fn fn) {
+        auto it = userIndex.find(userId);
+        if (it == userIndex.end()) return;
+        const auto& positions = it->second;
+        auto p = std::upper_bound(positions.begin(), positions.end(), position);
+        while (p != positions.begin()) {
+            if (!fn(slotAt(*--p).data)) return;
+        }
+    }
     
     bool remove(int id) {
-        if (head == nullptr) return false;
+        auto it = idIndex.find(id);
+        if (it == idIndex.end()) return false;
         
-        if (getIdFromData(head->data) == id) {
-            ListNode<T>* temp = head;
-            head = head->next;
-            delete temp;
-            size--;
-            return true;
-        }
+        int position = it->second;
+        Slot& slot = slotAt(position);
+        idIndex.erase(it);
         
-        ListNode<T>* current = head;
-        while (current->next != nullptr) {
-            if (getIdFromData(current->next->data) == id) {
-                ListNode<T>* temp = current->next;
-                current->next = current->next->next;
-                delete temp;
-                size--;
-                return true;
+        auto userIt = userIndex.find(slot.data.userId);
+        if (userIt != userIndex.end()) {
+            auto& positions = userIt->second;
+            positions.erase(std::remove(positions.begin(), positions.end(), position), positions.end());
+            if (positions.empty()) {
+                userIndex.erase(userIt);
             }
-            current = current->next;
         }
-        return false;
+        
+        slot.live = false;
+        slot.data = T();
+        size--;
+        return true;
     }
     
-private:
-    int getIdFromData(const Booking& b) { return b.bookingId; }
-    int getIdFromData(const FoodOrder& f) { return f.orderId; }
+    static int getIdFromData(const Booking& b) { return b.bookingId; }
+    static int getIdFromData(const FoodOrder& f) { return f.orderId; }
 };
 
 #endif // HOTEL_SYSTEM_H
\ No newline at end of file
@@ -1,9 +1,12 @@
 #define CROW_MAIN
 #include "crow_all.h"
 #include "HotelManager.h"
+#include "AssetCache.h"
+#include "IdempotencyCache.h"
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <limits>
 
 // Create data directory if it doesn't exist
 void createDataDirectory() {
@@ -15,60 +18,142 @@ void createDataDirectory() {
     #endif
 }
 
-// ---------- Utility: read a file from /static folder ----------
-std::string readFile(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) return "";
-    std::ostringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+// Wraps JSON text produced by JsonWriter
+crow::response jsonResponse(std::string body) {
+    crow::response res(std::move(body));
+    res.set_header("Content-Type", "application/json");
+    return res;
 }
 
-int main() {
+// Reads ?limit=&cursor=&order=asc|desc&fields= for list endpoints; false if limit isn't
+// a positive number or order is unknown
+bool readPageQuery(const crow::request& req, PageQuery& page, JsonWriter& json) {
+    const int MAX_PAGE_SIZE = 1000;
+    if (const char* limit = req.url_params.get("limit")) {
+        std::string_view text(limit);
+        auto result = std::from_chars(text.data(), text.data() + text.size(), page.limit);
+        if (result.ec != std::errc() || result.ptr != text.data() + text.size() || page.limit <= 0) return false;
+        page.limit = std::min(page.limit, MAX_PAGE_SIZE);
+    }
+    if (const char* cursor = req.url_params.get("cursor")) page.cursor = cursor;
+    if (const char* order = req.url_params.get("order")) {
+        std::string_view text(order);
+        if (text != "asc" && text != "desc") return false;
+        page.newestFirst = text == "desc";
+    }
+    if (const char* fields = req.url_params.get("fields")) json.selectFields(fields);
+    return true;
+}
+
+bool parseSnapshotFormat(const std::string& name, SnapshotFormat& format) {
+    if (name == "text") format = SnapshotFormat::Text;
+    else if (name == "binary") format = SnapshotFormat::Binary;
+    else return false;
+    return true;
+}
+
+bool parsePositive(const std::string& text, long& value) {
+    try {
+        size_t used = 0;
+        value = std::stol(text, &used);
+        return used == text.size() && value > 0;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Options:
+//   --snapshot=text|binary       format used for snapshots (default text)
+//   --convert-to=text|binary     write the current state in this format and exit
+//   --snapshot-interval=SECONDS  snapshot at least this often while there are changes
+//   --snapshot-mutations=N       snapshot after this many journaled changes
+//   --watch-assets               reload changed files in static/ (Linux only)
+//   --idempotency-ttl=SECONDS    how long Idempotency-Key responses are kept (default 86400)
+int main(int argc, char* argv[]) {
     createDataDirectory();
     
+    SnapshotFormat snapshotFormat = SnapshotFormat::Text;
+    CompactionPolicy compaction;
+    bool convert = false;
+    bool watchAssets = false;
+    long idempotencyTtl = 24 * 60 * 60;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool valid = false;
+        long number = 0;
+        if (arg.rfind("--snapshot=", 0) == 0) {
+            valid = parseSnapshotFormat(arg.substr(11), snapshotFormat);
+        } else if (arg.rfind("--convert-to=", 0) == 0) {
+            valid = parseSnapshotFormat(arg.substr(13), snapshotFormat);
+            convert = true;
+        } else if (arg == "--watch-assets") {
+            valid = true;
+            watchAssets = true;
+        } else if (arg.rfind("--snapshot-interval=", 0) == 0) {
+            valid = parsePositive(arg.substr(20), number);
+            compaction.interval = std::chrono::seconds(number);
+        } else if (arg.rfind("--snapshot-mutations=", 0) == 0) {
+            valid = parsePositive(arg.substr(21), number);
+            compaction.maxRecords = number;
+        } else if (arg.rfind("--idempotency-ttl=", 0) == 0) {
+            valid = parsePositive(arg.substr(18), idempotencyTtl);
+        }
+        if (!valid) {
+            std::cerr << "Usage: " << argv[0] << " [--snapshot=text|binary] [--convert-to=text|binary]"
+                      << " [--snapshot-interval=SECONDS] [--snapshot-mutations=N] [--watch-assets]"
+                      << " [--idempotency-ttl=SECONDS]" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Initialize the hotel management system
+    std::unique_ptr<HotelManager> manager;
+    try {
+        manager = std::make_unique<HotelManager>(snapshotFormat, compaction);
+    } catch (const std::exception& e) {
+        std::cerr << "Cannot load hotel data: " << e.what() << std::endl;
+        return 1;
+    }
+    HotelManager& hotelManager = *manager;
+    
+    if (convert) {
+        if (!hotelManager.convertSnapshot(snapshotFormat)) {
+            std::cerr << "Snapshot conversion failed" << std::endl;
+            return 1;
+        }
+        std::cout << "Snapshot converted" << std::endl;
+        return 0;
+    }
+    
     crow::SimpleApp app;
-    HotelManager hotelManager;  // Initialize the hotel management system
+
+    // Pages and assets are served from memory; see AssetCache
+    AssetCache assets("static");
+    std::cout << "Cached " << assets.loadAll() << " static files" << std::endl;
+    if (watchAssets && !assets.watch()) {
+        std::cerr << "Asset reload is not supported on this platform" << std::endl;
+    }
+
+    // Retried or double-submitted creates carrying an Idempotency-Key get the first response
+    const size_t IDEMPOTENCY_KEYS = 100000;
+    IdempotencyCache idempotency(IDEMPOTENCY_KEYS, std::chrono::seconds(idempotencyTtl));
 
     // ==================== STATIC FILES ====================
     CROW_ROUTE(app, "/assets/<path>")
-    ([](const crow::request&, std::string path) {
-        std::string filePath = "static/" + path;
-        auto content = readFile(filePath);
-        if (content.empty()) return crow::response(404);
-
-        crow::response res(content);
-        if (path.find(".css") != std::string::npos)
-            res.add_header("Content-Type", "text/css");
-        else if (path.find(".js") != std::string::npos)
-            res.add_header("Content-Type", "application/javascript");
-        else if (path.find(".png") != std::string::npos)
-            res.add_header("Content-Type", "image/png");
-        else if (path.find(".jpg") != std::string::npos)
-            res.add_header("Content-Type", "image/jpeg");
-        else if (path.find(".html") != std::string::npos)
-            res.add_header("Content-Type", "text/html");
-        return res;
+    ([&assets](const crow::request& req, std::string path) {
+        return assets.serve(req, path);
     });
 
     // ==================== HOMEPAGE ====================
-    CROW_ROUTE(app, "/")([]() {
-        std::string html = readFile("static/index.html");
-        if (html.empty()) return crow::response(404, "index.html not found");
-        crow::response res(html);
-        res.add_header("Content-Type", "text/html");
-        return res;
+    CROW_ROUTE(app, "/")([&assets](const crow::request& req) {
+        return assets.serve(req, "index.html");
     });
 
     // ==================== LOGIN ====================
     CROW_ROUTE(app, "/login").methods(crow::HTTPMethod::Get, crow::HTTPMethod::Post)
-    ([](const crow::request& req) {
+    ([&assets](const crow::request& req) {
         if (req.method == crow::HTTPMethod::Get) {
-            auto html = readFile("static/login.html");
-            if (html.empty()) return crow::response(404, "login.html not found");
-            crow::response res(html);
-            res.add_header("Content-Type", "text/html");
-            return res;
+            return assets.serve(req, "login.html");
         }
 
         if (req.method == crow::HTTPMethod::Post) {
@@ -108,13 +193,9 @@ int main() {
 
     // ==================== REGISTER ====================
     CROW_ROUTE(app, "/register").methods(crow::HTTPMethod::Get, crow::HTTPMethod::Post)
-    ([&hotelManager](const crow::request& req) {
+    ([&hotelManager, &assets](const crow::request& req) {
         if (req.method == crow::HTTPMethod::Get) {
-            auto html = readFile("static/register.html");
-            if (html.empty()) return crow::response(404, "register.html not found");
-            crow::response res(html);
-            res.add_header("Content-Type", "text/html");
-            return res;
+            return assets.serve(req, "register.html");
         }
 
         if (req.method == crow::HTTPMethod::Post) {
@@ -142,11 +223,15 @@ int main() {
     
     // Get all users
     CROW_ROUTE(app, "/api/admin/users")
-    ([&hotelManager]() {
-        auto users = hotelManager.getAllUsers();
-        crow::json::wvalue response;
-        response["users"] = std::move(users);
-        return crow::response(response);
+    ([&hotelManager](const crow::request& req) {
+        std::string body;
+        JsonWriter json(body);
+        PageQuery page;
+        if (!readPageQuery(req, page, json)) return crow::response(400, "Invalid limit or order");
+        json.beginObject();
+        hotelManager.writeUsers(json, page);
+        json.endObject();
+        return jsonResponse(std::move(body));
     });
 
     // Create user (admin creates staff/admin accounts)
@@ -181,40 +266,102 @@ int main() {
     });
 
     // ==================== USER DASHBOARD ====================
-    CROW_ROUTE(app, "/dashboard")([]() {
-        auto html = readFile("static/dashboard.html");
-        if (html.empty()) return crow::response(404, "dashboard.html not found");
-        crow::response res(html);
-        res.add_header("Content-Type", "text/html");
-        return res;
+    CROW_ROUTE(app, "/dashboard")([&assets](const crow::request& req) {
+        return assets.serve(req, "dashboard.html");
     });
 
-    CROW_ROUTE(app, "/user_book_room")([]() {
-        auto html = readFile("static/user_book_room.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/user_book_room")([&assets](const crow::request& req) {
+        return assets.serve(req, "user_book_room.html");
     });
 
-    CROW_ROUTE(app, "/user_order_food")([]() {
-        auto html = readFile("static/user_order_food.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/user_order_food")([&assets](const crow::request& req) {
+        return assets.serve(req, "user_order_food.html");
     });
 
-    CROW_ROUTE(app, "/user_view_bill")([]() {
-        auto html = readFile("static/user_view_bill.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/user_view_bill")([&assets](const crow::request& req) {
+        return assets.serve(req, "user_view_bill.html");
     });
 
     // ==================== ROOM API ENDPOINTS ====================
     
     // Get all available rooms
+    // With ?from=YYYY-MM-DD&to=YYYY-MM-DD, rooms free for that whole stay; &type= narrows
+    // either form to one room type
     CROW_ROUTE(app, "/api/rooms/available")
-    ([&hotelManager]() {
-        auto rooms = hotelManager.getAvailableRooms();
+    ([&hotelManager](const crow::request& req) {
+        const char* fromParam = req.url_params.get("from");
+        const char* toParam = req.url_params.get("to");
+        const char* typeParam = req.url_params.get("type");
+        std::vector<RoomType> types;
+        if (typeParam != nullptr) {
+            RoomType type;
+            if (!parse(typeParam, type)) return crow::response(400, "Invalid room type");
+            types.push_back(type);
+        } else {
+            for (int i = 0; i < ROOM_TYPE_COUNT; i++) types.push_back(static_cast<RoomType>(i));
+        }
+        
+        std::vector<crow::json::wvalue> rooms;
+        if (fromParam != nullptr || toParam != nullptr) {
+            int from, to;
+            if (fromParam == nullptr || toParam == nullptr ||
+                !parseDate(fromParam, from) || !parseDate(toParam, to) || from >= to) {
+                return crow::response(400, "Invalid date range");
+            }
+            rooms = hotelManager.getAvailableRooms(from, to, types);
+        } else if (typeParam != nullptr) {
+            rooms = hotelManager.getRoomsByType(typeParam);
+        } else {
+            rooms = hotelManager.getAvailableRooms();
+        }
         crow::json::wvalue response;
         response["rooms"] = std::move(rooms);
         return crow::response(response);
     });
 
+    // Cheapest rooms free for a stay:
+    //   /api/rooms/search?from=YYYY-MM-DD&to=YYYY-MM-DD[&type=][&guests=][&maxPrice=][&limit=]
+    CROW_ROUTE(app, "/api/rooms/search")
+    ([&hotelManager](const crow::request& req) {
+        const int DEFAULT_LIMIT = 10;
+        const int MAX_LIMIT = 100;
+        try {
+            const char* fromParam = req.url_params.get("from");
+            const char* toParam = req.url_params.get("to");
+            int from, to;
+            if (fromParam == nullptr || toParam == nullptr ||
+                !parseDate(fromParam, from) || !parseDate(toParam, to) || from >= to) {
+                return crow::response(400, "Invalid date range");
+            }
+            
+            int guests = req.url_params.get("guests") ? std::stoi(req.url_params.get("guests")) : 1;
+            double maxPrice = req.url_params.get("maxPrice") ? std::stod(req.url_params.get("maxPrice"))
+                                                             : std::numeric_limits<double>::infinity();
+            int limit = req.url_params.get("limit") ? std::stoi(req.url_params.get("limit")) : DEFAULT_LIMIT;
+            if (guests < 1 || limit < 1) return crow::response(400, "Invalid search parameters");
+            limit = std::min(limit, MAX_LIMIT);
+            
+            // Only types that sleep the whole party are searched
+            std::vector<RoomType> types;
+            if (const char* typeParam = req.url_params.get("type")) {
+                RoomType type;
+                if (!parse(typeParam, type)) return crow::response(400, "Invalid room type");
+                types.push_back(type);
+            } else {
+                for (int i = 0; i < ROOM_TYPE_COUNT; i++) types.push_back(static_cast<RoomType>(i));
+            }
+            types.erase(std::remove_if(types.begin(), types.end(),
+                                       [&](RoomType type) { return capacityOf(type) < guests; }),
+                        types.end());
+            
+            crow::json::wvalue response;
+            response["rooms"] = hotelManager.searchRooms(types, from, to, maxPrice, limit);
+            return crow::response(response);
+        } catch (...) {
+            return crow::response(400, "Invalid search parameters");
+        }
+    });
+
     // Get rooms by type
     CROW_ROUTE(app, "/api/rooms/type/<string>")
     ([&hotelManager](std::string type) {
@@ -234,10 +381,12 @@ int main() {
     // Get all rooms (admin only)
     CROW_ROUTE(app, "/api/admin/rooms")
     ([&hotelManager]() {
-        auto rooms = hotelManager.getAllRooms();
-        crow::json::wvalue response;
-        response["rooms"] = std::move(rooms);
-        return crow::response(response);
+        std::string body;
+        JsonWriter json(body);
+        json.beginObject();
+        hotelManager.writeAllRooms(json);
+        json.endObject();
+        return jsonResponse(std::move(body));
     });
 
     // Add new room (admin only)
@@ -247,14 +396,24 @@ int main() {
             auto body = crow::json::load(req.body);
             if (!body) return crow::response(400, "Invalid JSON");
 
+            RoomType type;
+            RoomStatus status;
+            if (!parse(std::string(body["type"].s()), type) ||
+                !parse(std::string(body["status"].s()), status)) {
+                return crow::response(400, "Invalid room type or status");
+            }
+
             Room room(
                 body["roomNumber"].i(),
-                body["type"].s(),
+                type,
                 body["pricePerNight"].d(),
-                body["status"].s(),
+                status,
                 body["floor"].i(),
                 body["features"].s()
             );
+            if (hasControlCharacters(room.features)) {
+                return crow::response(400, "Features can't contain control characters");
+            }
 
             bool success = hotelManager.addRoom(room);
             crow::json::wvalue response;
@@ -273,14 +432,24 @@ int main() {
             auto body = crow::json::load(req.body);
             if (!body) return crow::response(400, "Invalid JSON");
 
+            RoomType type;
+            RoomStatus status;
+            if (!parse(std::string(body["type"].s()), type) ||
+                !parse(std::string(body["status"].s()), status)) {
+                return crow::response(400, "Invalid room type or status");
+            }
+
             Room room(
                 roomNumber,
-                body["type"].s(),
+                type,
                 body["pricePerNight"].d(),
-                body["status"].s(),
+                status,
                 body["floor"].i(),
                 body["features"].s()
             );
+            if (hasControlCharacters(room.features)) {
+                return crow::response(400, "Features can't contain control characters");
+            }
 
             bool success = hotelManager.updateRoom(roomNumber, room);
             crow::json::wvalue response;
@@ -306,39 +475,59 @@ int main() {
     
     // Create new booking
     CROW_ROUTE(app, "/api/bookings/create").methods(crow::HTTPMethod::Post)
-    ([&hotelManager](const crow::request& req) {
-        try {
-            auto body = crow::json::load(req.body);
-            if (!body) return crow::response(400, "Invalid JSON");
+    ([&hotelManager, &idempotency](const crow::request& req) {
+        return idempotency.run(req, "bookings", [&]() {
+            try {
+                auto body = crow::json::load(req.body);
+                if (!body) return crow::response(400, "Invalid JSON");
 
-            std::string userId = body["userId"].s();
-            int roomNumber = body["roomNumber"].i();
-            std::string checkIn = body["checkInDate"].s();
-            std::string checkOut = body["checkOutDate"].s();
-            int nights = body["nights"].i();
+                std::string userId = body["userId"].s();
+                int roomNumber = body["roomNumber"].i();
+                std::string checkIn = body["checkInDate"].s();
+                std::string checkOut = body["checkOutDate"].s();
+                int nights = body["nights"].i();
+                bool anyRoomOfType = body.has("anyRoomOfType") && body["anyRoomOfType"].b();
 
-            auto result = hotelManager.createBooking(userId, roomNumber, checkIn, checkOut, nights);
-            return crow::response(result);
-        } catch (...) {
-            return crow::response(400, "Error processing booking");
-        }
+                auto result = hotelManager.createBooking(userId, roomNumber, checkIn, checkOut, nights, anyRoomOfType);
+                return crow::response(result);
+            } catch (...) {
+                return crow::response(400, "Error processing booking");
+            }
+        });
     });
 
     // Get user bookings
     CROW_ROUTE(app, "/api/bookings/user/<string>")
-    ([&hotelManager](std::string userId) {
-        auto bookings = hotelManager.getUserBookings(userId);
-        crow::json::wvalue response;
-        response["bookings"] = std::move(bookings);
-        return crow::response(response);
+    ([&hotelManager](const crow::request& req, std::string userId) {
+        std::string body;
+        JsonWriter json(body);
+        PageQuery page;
+        if (!readPageQuery(req, page, json)) return crow::response(400, "Invalid limit or order");
+        json.beginObject();
+        if (!hotelManager.writeUserBookings(json, userId, page)) return crow::response(400, "Invalid cursor");
+        json.endObject();
+        return jsonResponse(std::move(body));
     });
 
     // Get all bookings (admin/staff)
     CROW_ROUTE(app, "/api/bookings/all")
-    ([&hotelManager]() {
-        auto bookings = hotelManager.getAllBookings();
+    ([&hotelManager](const crow::request& req) {
+        std::string body;
+        JsonWriter json(body);
+        PageQuery page;
+        if (!readPageQuery(req, page, json)) return crow::response(400, "Invalid limit or order");
+        json.beginObject();
+        if (!hotelManager.writeAllBookings(json, page)) return crow::response(400, "Invalid cursor");
+        json.endObject();
+        return jsonResponse(std::move(body));
+    });
+
+    // Waiting bookings and their positions; ?userId= for one guest's
+    CROW_ROUTE(app, "/api/waitlist")
+    ([&hotelManager](const crow::request& req) {
+        const char* userId = req.url_params.get("userId");
         crow::json::wvalue response;
-        response["bookings"] = std::move(bookings);
+        response["waitlist"] = hotelManager.getWaitlist(userId ? userId : "");
         return crow::response(response);
     });
 
@@ -373,28 +562,30 @@ int main() {
     
     // Create food order
     CROW_ROUTE(app, "/api/orders/create").methods(crow::HTTPMethod::Post)
-    ([&hotelManager](const crow::request& req) {
-        try {
-            auto body = crow::json::load(req.body);
-            if (!body) return crow::response(400, "Invalid JSON");
+    ([&hotelManager, &idempotency](const crow::request& req) {
+        return idempotency.run(req, "orders", [&]() {
+            try {
+                auto body = crow::json::load(req.body);
+                if (!body) return crow::response(400, "Invalid JSON");
 
-            std::string userId = body["userId"].s();
-            int roomNumber = body["roomNumber"].i();
-            double totalPrice = body["totalPrice"].d();
-            
-            std::vector<std::pair<std::string, int>> items;
-            auto itemsJson = body["items"];
-            for (size_t i = 0; i < itemsJson.size(); i++) {
-                std::string name = itemsJson[i]["name"].s();
-                int quantity = itemsJson[i]["quantity"].i();
-                items.push_back({name, quantity});
-            }
+                std::string userId = body["userId"].s();
+                int roomNumber = body["roomNumber"].i();
+                double totalPrice = body["totalPrice"].d();
+                
+                std::vector<std::pair<std::string, int>> items;
+                auto itemsJson = body["items"];
+                for (size_t i = 0; i < itemsJson.size(); i++) {
+                    std::string name = itemsJson[i]["name"].s();
+                    int quantity = itemsJson[i]["quantity"].i();
+                    items.push_back({name, quantity});
+                }
 
-            auto result = hotelManager.createFoodOrder(userId, roomNumber, items, totalPrice);
-            return crow::response(result);
-        } catch (...) {
-            return crow::response(400, "Error processing order");
-        }
+                auto result = hotelManager.createFoodOrder(userId, roomNumber, items, totalPrice);
+                return crow::response(result);
+            } catch (...) {
+                return crow::response(400, "Error processing order");
+            }
+        });
     });
 
     // Get user orders
@@ -408,11 +599,15 @@ int main() {
 
     // Get all orders (staff)
     CROW_ROUTE(app, "/api/orders/all")
-    ([&hotelManager]() {
-        auto orders = hotelManager.getAllOrders();
-        crow::json::wvalue response;
-        response["orders"] = std::move(orders);
-        return crow::response(response);
+    ([&hotelManager](const crow::request& req) {
+        std::string body;
+        JsonWriter json(body);
+        PageQuery page;
+        if (!readPageQuery(req, page, json)) return crow::response(400, "Invalid limit or order");
+        json.beginObject();
+        if (!hotelManager.writeAllOrders(json, page)) return crow::response(400, "Invalid cursor");
+        json.endObject();
+        return jsonResponse(std::move(body));
     });
 
     // ==================== SERVICE REQUEST API ENDPOINTS ====================
@@ -464,55 +659,45 @@ int main() {
     });
 
     // ==================== STAFF ROUTES ====================
-    CROW_ROUTE(app, "/staff_dashboard")([]() {
-        auto html = readFile("static/staff_dashboard.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/staff_dashboard")([&assets](const crow::request& req) {
+        return assets.serve(req, "staff_dashboard.html");
     });
 
-    CROW_ROUTE(app, "/check_in")([](){
-        auto html = readFile("static/staff_check_in.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/check_in")([&assets](const crow::request& req) {
+        return assets.serve(req, "staff_check_in.html");
     });
 
-    CROW_ROUTE(app, "/room_cleaning")([](){
-        auto html = readFile("static/staff_room_cleaning.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/room_cleaning")([&assets](const crow::request& req) {
+        return assets.serve(req, "staff_room_cleaning.html");
     });
 
-    CROW_ROUTE(app, "/service_requests")([](){
-        auto html = readFile("static/staff_service_requests.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/service_requests")([&assets](const crow::request& req) {
+        return assets.serve(req, "staff_service_requests.html");
     });
 
-    CROW_ROUTE(app, "/reports")([](){
-        auto html = readFile("static/staff_reports.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/reports")([&assets](const crow::request& req) {
+        return assets.serve(req, "staff_reports.html");
     });
 
     // ==================== ADMIN ROUTES ====================
-    CROW_ROUTE(app, "/admin_dashboard")([]() {
-        auto html = readFile("static/admin_dashboard.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/admin_dashboard")([&assets](const crow::request& req) {
+        return assets.serve(req, "admin_dashboard.html");
     });
 
-    CROW_ROUTE(app, "/admin_manage_rooms")([]() {
-        auto html = readFile("static/admin_manage_rooms.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/admin_manage_rooms")([&assets](const crow::request& req) {
+        return assets.serve(req, "admin_manage_rooms.html");
     });
 
-    CROW_ROUTE(app, "/admin_manage_staff")([]() {
-        auto html = readFile("static/admin_manage_staff.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/admin_manage_staff")([&assets](const crow::request& req) {
+        return assets.serve(req, "admin_manage_staff.html");
     });
 
-    CROW_ROUTE(app, "/admin_view_reports")([]() {
-        auto html = readFile("static/admin_view_reports.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/admin_view_reports")([&assets](const crow::request& req) {
+        return assets.serve(req, "admin_view_reports.html");
     });
 
-    CROW_ROUTE(app, "/admin_settings")([]() {
-        auto html = readFile("static/admin_settings.html");
-        return html.empty() ? crow::response(404) : crow::response(html);
+    CROW_ROUTE(app, "/admin_settings")([&assets](const crow::request& req) {
+        return assets.serve(req, "admin_settings.html");
     });
 
     // ==================== RUN SERVER ====================
@@ -0,0 +1,179 @@
+// Round-trip tests for the .dat line formats: every record written with
+// toFileString() must read back unchanged through fromFileString(), including the
+// edge cases the formats have to survive (empty item lists, ':' inside item names,
+// empty trailing fields, the optional Booking flag, separators inside free text).
+// Binary snapshots are checked the same way.
+//
+// Build and run (like test.cpp; add -DCROW_USE_BOOST where Crow needs Boost.Asio):
+//   g++ roundtrip_test.cpp -o roundtrip_test.exe -std=c++17 -pthread -lws2_32 -lwsock32
+//   ./roundtrip_test.exe
+#define CROW_MAIN
+#include "crow_all.h"
+#include "hotel_system.h"
+#include "BinarySnapshot.h"
+#include <iostream>
+#include <string>
+
+int failures = 0;
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << #condition << std::endl; \
+            failures++;                                                               \
+        }                                                                             \
+    } while (0)
+
+bool sameOrder(const FoodOrder& a, const FoodOrder& b) {
+    return a.orderId == b.orderId && a.userId == b.userId && a.roomNumber == b.roomNumber &&
+           a.items == b.items && a.totalPrice == b.totalPrice && a.status == b.status &&
+           a.orderTime == b.orderTime;
+}
+
+bool sameRequest(const ServiceRequest& a, const ServiceRequest& b) {
+    return a.requestId == b.requestId && a.roomNumber == b.roomNumber && a.type == b.type &&
+           a.description == b.description && a.priority == b.priority && a.status == b.status &&
+           a.requestTime == b.requestTime && a.assignedTo == b.assignedTo;
+}
+
+bool sameBooking(const Booking& a, const Booking& b) {
+    return a.bookingId == b.bookingId && a.userId == b.userId && a.roomNumber == b.roomNumber &&
+           a.checkInDate == b.checkInDate && a.checkOutDate == b.checkOutDate && a.nights == b.nights &&
+           a.totalAmount == b.totalAmount && a.status == b.status && a.bookingDate == b.bookingDate &&
+           a.anyRoomOfType == b.anyRoomOfType;
+}
+
+FoodOrder makeOrder(std::vector<std::pair<std::string, int>> items) {
+    FoodOrder order;
+    order.orderId = 1042;
+    order.userId = "guest7";
+    order.roomNumber = 305;
+    order.items = std::move(items);
+    order.totalPrice = 472.5;
+    order.status = OrderStatus::Preparing;
+    order.orderTime = "17/10/2026 09:15";
+    return order;
+}
+
+void testFoodOrders() {
+    FoodOrder usual = makeOrder({{"Masala Dosa", 2}, {"Coffee", 1}});
+    CHECK(sameOrder(FoodOrder::fromFileString(usual.toFileString()), usual));
+
+    FoodOrder empty = makeOrder({});
+    FoodOrder emptyBack = FoodOrder::fromFileString(empty.toFileString());
+    CHECK(emptyBack.items.empty());
+    CHECK(sameOrder(emptyBack, empty));
+
+    // The quantity follows the last ':' of an item, so names may contain ':'
+    FoodOrder colons = makeOrder({{"Combo: Tea:Biscuits", 3}, {"Juice:", 1}});
+    FoodOrder colonsBack = FoodOrder::fromFileString(colons.toFileString());
+    CHECK(colonsBack.items.size() == 2);
+    CHECK(sameOrder(colonsBack, colons));
+
+    // Separators of every level inside names are escaped, not split on
+    FoodOrder separators = makeOrder({{"Tea|2\nORDER|1|x", 1}, {"Chai, masala: large %", 2}, {"", 3}});
+    std::string separatorsLine = separators.toFileString();
+    CHECK(separatorsLine.find('\n') == std::string::npos);
+    CHECK(sameOrder(FoodOrder::fromFileString(separatorsLine), separators));
+
+    // Order times contain ':' as well
+    CHECK(FoodOrder::fromFileString(usual.toFileString()).orderTime == "17/10/2026 09:15");
+
+    CHECK(FoodOrder::fromFileString("not an order").orderId == 0);
+}
+
+void testServiceRequests() {
+    ServiceRequest assigned(2001, 204, ServiceType::RoomService, "Extra towels: two", 1,
+                            ServiceStatus::InProgress, "17/10/2026 10:30", "staff");
+    CHECK(sameRequest(ServiceRequest::fromFileString(assigned.toFileString()), assigned));
+
+    // An unassigned request ends in an empty field
+    ServiceRequest unassigned(2002, 101, ServiceType::Emergency, "", 2,
+                              ServiceStatus::Pending, "17/10/2026 11:00", "");
+    CHECK(sameRequest(ServiceRequest::fromFileString(unassigned.toFileString()), unassigned));
+
+    ServiceRequest separators(2004, 305, ServiceType::Maintenance, "Tap: leaking|\nROOM_DELETE|305\r 100%", 1,
+                              ServiceStatus::Pending, "17/10/2026 11:30", "night|staff");
+    std::string separatorsLine = separators.toFileString();
+    CHECK(separatorsLine.find('\n') == std::string::npos && separatorsLine.find('\r') == std::string::npos);
+    CHECK(sameRequest(ServiceRequest::fromFileString(separatorsLine), separators));
+
+    CHECK(ServiceRequest::fromFileString("2003|101").requestId == 0);
+}
+
+void testBookings() {
+    Booking plain(1001, "guest7", 102, "2026-11-01", "2026-11-04", 3, 4500.0,
+                  BookingStatus::Confirmed, "17/10/2026 12:00");
+    Booking anyRoom(1002, "guest8", 201, "2026-11-02", "2026-11-03", 1, 2500.0,
+                    BookingStatus::Waiting, "17/10/2026 12:05", true);
+
+    CHECK(plain.toFileString().find("AnyRoom") == std::string::npos);
+    CHECK(sameBooking(Booking::fromFileString(plain.toFileString()), plain));
+    CHECK(sameBooking(Booking::fromFileString(anyRoom.toFileString()), anyRoom));
+
+    // Lines written before the flag existed still parse, without it
+    Booking legacy = Booking::fromFileString(
+        "1003|guest9|103|2026-11-05|2026-11-06|1|1500.000000|Confirmed|17/10/2026 12:10");
+    CHECK(legacy.bookingId == 1003);
+    CHECK(!legacy.anyRoomOfType);
+}
+
+// Free text is escaped, so separators inside it can't add records or fields
+void testEscapedFields() {
+    User user("eve", "p|w%", "x\nUSER|mallory|pw|M|m@x|1|admin", "e@x\r", "1|2", "user");
+    std::string line = user.toFileString();
+    CHECK(line.find('\n') == std::string::npos && line.find('\r') == std::string::npos);
+    User userBack = User::fromFileString(line);
+    CHECK(userBack.userId == user.userId && userBack.password == user.password && userBack.name == user.name &&
+          userBack.email == user.email && userBack.phone == user.phone && userBack.role == user.role);
+
+    Room room(101, RoomType::Suite, 5000.0, RoomStatus::Available, 3, "AC|x\nROOM_DELETE|102 %7C 50%");
+    Room roomBack = Room::fromFileString(room.toFileString());
+    CHECK(roomBack.roomNumber == 101 && roomBack.floor == 3 && roomBack.features == room.features);
+
+    Booking booking(1004, "guest|7\n", 104, "2026-11-05", "2026-11-06", 1, 1500.0,
+                    BookingStatus::Confirmed, "17/10/2026 12:10", true);
+    CHECK(sameBooking(Booking::fromFileString(booking.toFileString()), booking));
+
+    // Unescaped text from older files reads back unchanged, stray '%' included
+    CHECK(Room::fromFileString("102|Single|1500.000000|Available|1|AC, TV, 10% off").features == "AC, TV, 10% off");
+}
+
+void testBinarySnapshot() {
+    SnapshotData data;
+    data.rooms.push_back(Room(101, RoomType::Single, 1499.99, RoomStatus::Reserved, 1, "AC, TV"));
+    data.users.push_back(User("guest7", "pw", "Guest Seven", "g7@hotel.com", "123", "user"));
+    data.bookings.push_back(Booking(1001, "guest7", 101, "2026-11-01", "2026-11-04", 3, 4499.97,
+                                    BookingStatus::Waiting, "17/10/2026 12:00", true));
+    data.orders.push_back(makeOrder({}));
+    data.orders.push_back(makeOrder({{"Combo: Tea:Biscuits", 3}, {"Tea|2\n", 1}}));
+    data.requests.push_back(ServiceRequest(2001, 101, ServiceType::Cleaning, "", 3,
+                                           ServiceStatus::Pending, "17/10/2026 10:30", ""));
+
+    std::string bytes = SnapshotWriter().serialize(data);
+    SnapshotData back;
+    std::string error;
+    CHECK(SnapshotReader().read(bytes, back, error));
+    CHECK(back.bookings.size() == 1 && sameBooking(back.bookings[0], data.bookings[0]));
+    CHECK(back.orders.size() == 2 && sameOrder(back.orders[0], data.orders[0]) &&
+          sameOrder(back.orders[1], data.orders[1]));
+    CHECK(back.requests.size() == 1 && sameRequest(back.requests[0], data.requests[0]));
+
+    bytes[bytes.size() / 2] ^= 1;
+    CHECK(!SnapshotReader().read(bytes, back, error));
+}
+
+int main() {
+    testFoodOrders();
+    testServiceRequests();
+    testBookings();
+    testEscapedFields();
+    testBinarySnapshot();
+
+    if (failures > 0) {
+        std::cout << "FAIL (" << failures << " checks)" << std::endl;
+        return 1;
+    }
+    std::cout << "PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Stress test for HotelManager's locking: worker threads hammer a mix of the calls
+// the routes make (bookings, check-in/out, cancellations, availability searches,
+// list exports, orders, service requests, maintenance toggles) while a checker
+// thread keeps verifying invariants. Snapshots are forced often so compaction runs
+// concurrently too, and the state is reloaded at the end to check it persisted.
+//
+// Build and run (like test.cpp; add -DCROW_USE_BOOST where Crow needs Boost.Asio):
+//   g++ stress_test.cpp -o stress_test.exe -std=c++17 -pthread -lws2_32 -lwsock32
+//   ./stress_test.exe [threads] [operations per thread]
+// It works in a scratch directory under the system temp dir, never in data/.
+#define CROW_MAIN
+#include "crow_all.h"
+#include "HotelManager.h"
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Day offset 0..60 from 2026-11-01 as "YYYY-MM-DD"
+std::string dateAt(int offset) {
+    char text[24];
+    if (offset < 30) {
+        std::snprintf(text, sizeof(text), "2026-11-%02d", offset + 1);
+    } else {
+        std::snprintf(text, sizeof(text), "2026-12-%02d", offset - 29);
+    }
+    return text;
+}
+
+int intField(const crow::json::wvalue& value, const char* name) {
+    auto parsed = crow::json::load(value.dump());
+    return (parsed && parsed.has(name)) ? (int)parsed[name].i() : 0;
+}
+
+int main(int argc, char* argv[]) {
+    int threadCount = argc > 1 ? std::atoi(argv[1]) : 16;
+    int operations = argc > 2 ? std::atoi(argv[2]) : 1000;
+    if (threadCount <= 0 || operations <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [threads] [operations per thread]" << std::endl;
+        return 1;
+    }
+
+    std::filesystem::path scratch = std::filesystem::temp_directory_path() / "hotel_stress_test";
+    std::filesystem::remove_all(scratch);
+    std::filesystem::create_directories(scratch / "data");
+    std::filesystem::current_path(scratch);
+
+    CompactionPolicy compaction;
+    compaction.maxRecords = 500;
+
+    int bookingsBefore = 0;
+    bool consistent = true;
+    {
+        HotelManager hotel(SnapshotFormat::Text, compaction);
+        std::vector<int> rooms;
+        for (const auto& room : hotel.getAvailableRooms()) {
+            rooms.push_back(intField(room, "roomNumber"));
+        }
+
+        std::atomic<bool> running{true};
+        std::atomic<int> checks{0};
+        std::atomic<int> failedChecks{0};
+        std::thread checker([&]() {
+            while (running) {
+                if (!hotel.checkConsistency()) failedChecks++;
+                checks++;
+                // Back-to-back read locks would starve the writers being tested
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        });
+
+        auto worker = [&](int seed) {
+            std::mt19937 random(seed);
+            auto pick = [&](int n) { return (int)(random() % n); };
+            std::vector<int> myBookings;
+            std::string userId = "stress" + std::to_string(seed);
+
+            for (int i = 0; i < operations; i++) {
+                int from = pick(56);
+                int to = from + 1 + pick(4);
+                int room = rooms[pick((int)rooms.size())];
+                int op = pick(100);
+
+                if (op < 35) {
+                    auto result = hotel.createBooking(userId, room, dateAt(from), dateAt(to), to - from, pick(10) == 0);
+                    if (int id = intField(result, "bookingId")) myBookings.push_back(id);
+                } else if (op < 45 && !myBookings.empty()) {
+                    hotel.cancelBooking(myBookings[pick((int)myBookings.size())]);
+                } else if (op < 53 && !myBookings.empty()) {
+                    hotel.checkIn(myBookings[pick((int)myBookings.size())]);
+                } else if (op < 61 && !myBookings.empty()) {
+                    hotel.checkOut(myBookings[pick((int)myBookings.size())]);
+                } else if (op < 71) {
+                    hotel.getAvailableRooms(from, to, {static_cast<RoomType>(pick(ROOM_TYPE_COUNT))});
+                } else if (op < 77) {
+                    hotel.searchRooms({static_cast<RoomType>(pick(ROOM_TYPE_COUNT))}, from, to, 1e9, 5);
+                } else if (op < 83) {
+                    hotel.getDashboardStats();
+                } else if (op < 88) {
+                    std::string body;
+                    JsonWriter json(body);
+                    PageQuery page;
+                    page.limit = 50;
+                    json.beginObject();
+                    hotel.writeAllBookings(json, page);
+                    json.endObject();
+                } else if (op < 92) {
+                    hotel.createFoodOrder(userId, room, {{"Tea", 1 + pick(3)}}, 50.0);
+                } else if (op < 95) {
+                    hotel.createServiceRequest(room, SERVICE_TYPE_NAMES[pick(SERVICE_TYPE_COUNT)], "stress", 1 + pick(5));
+                } else if (op < 98) {
+                    hotel.updateRoomStatus(room, pick(2) == 0 ? RoomStatus::Maintenance : RoomStatus::Available);
+                } else {
+                    hotel.getWaitlist("");
+                }
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; t++) {
+            workers.emplace_back(worker, t + 1);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+        running = false;
+        checker.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << threadCount << " threads x " << operations << " operations in " << seconds << " s ("
+                  << (int)(threadCount * operations / seconds) << " ops/s); " << checks << " concurrent checks, "
+                  << failedChecks << " failed" << std::endl;
+        consistent = failedChecks == 0 && hotel.checkConsistency();
+        bookingsBefore = intField(hotel.getDashboardStats(), "totalBookings");
+    }
+
+    // Everything was journaled (and partly compacted), so a reload must see it all
+    HotelManager reloaded(SnapshotFormat::Text, compaction);
+    int bookingsAfter = intField(reloaded.getDashboardStats(), "totalBookings");
+    if (bookingsAfter != bookingsBefore) {
+        std::cerr << "Reload found " << bookingsAfter << " bookings, expected " << bookingsBefore << std::endl;
+        consistent = false;
+    }
+    consistent = reloaded.checkConsistency() && consistent;
+
+    std::cout << (consistent ? "PASS" : "FAIL") << " (" << bookingsBefore << " bookings)" << std::endl;
+    return consistent ? 0 : 1;
+}